@@ -3,6 +3,7 @@
 
 // Qt Includes
 #include <QCoreApplication>
+#include <QThread>
 
 // Qx Includes
 #include <qx/core/qx-iostream.h>
@@ -47,7 +48,10 @@ Core::Core(QCoreApplication* app) :
     mArguments(app->arguments()),
     mRefElectionCfg(std::nullopt),
     mCalcOptions(Star::Calculator::NoOptions),
-    mMinimal(false)
+    mThreadCount(QThread::idealThreadCount()),
+    mMinimal(false),
+    mSummarize(false),
+    mPatterns(false)
 {
     // Logger tweaks
     mLogger.setMaximumEntries(50);
@@ -101,7 +105,12 @@ void Core::showVersion()
 
 void Core::logElectionData(const ReferenceElectionConfig& data)
 {
-    logEvent(NAME, LOG_EVENT_ELECTION_DATA_PROVIDED.arg(data.bbPath, data.ccPath));
+    if(data.isBinary())
+        logEvent(NAME, LOG_EVENT_BINARY_ELECTION_DATA_PROVIDED.arg(data.binPath));
+    else if(data.isPrecincts())
+        logEvent(NAME, LOG_EVENT_PRECINCT_ELECTION_DATA_PROVIDED.arg(data.precinctDir, data.ccPath));
+    else
+        logEvent(NAME, LOG_EVENT_ELECTION_DATA_PROVIDED.arg(data.bbPath, data.ccPath));
 }
 
 //Public:
@@ -141,16 +150,52 @@ Qx::Error Core::initialize()
         showHelp();
         logEvent(NAME, LOG_EVENT_G_HELP_SHOWN);
     }
-    else if(clParser.isSet(CL_OPTION_CONFIG) && clParser.isSet(CL_OPTION_BOX))
+    else if(clParser.isSet(CL_OPTION_SAVE_BINARY) && !(clParser.isSet(CL_OPTION_CONFIG) && clParser.isSet(CL_OPTION_BOX)))
+    {
+        CoreError err(CoreError::InvalidArgs, ERR_CONVERT_NEEDS_REF_PATHS);
+        postError(NAME, err);
+        return err;
+    }
+    else if(clParser.isSet(CL_OPTION_SAVE_BINARY) && clParser.isSet(CL_OPTION_SUMMARIZE))
+    {
+        CoreError err(CoreError::InvalidArgs, ERR_CONVERT_NEEDS_BALLOTS);
+        postError(NAME, err);
+        return err;
+    }
+    else if((clParser.isSet(CL_OPTION_CONFIG) && (clParser.isSet(CL_OPTION_BOX) || clParser.isSet(CL_OPTION_PRECINCTS))) ||
+            clParser.isSet(CL_OPTION_BINARY_BOX))
     {
-        // Setup election data container
-        mRefElectionCfg = ReferenceElectionConfig{
-            .ccPath = clParser.value(CL_OPTION_CONFIG),
-            .bbPath = clParser.value(CL_OPTION_BOX),
-        };
+        // Setup election data container, preferring the reference format, then precincts, if more than one is provided
+        if(clParser.isSet(CL_OPTION_CONFIG) && clParser.isSet(CL_OPTION_BOX))
+        {
+            mRefElectionCfg = ReferenceElectionConfig{
+                .ccPath = clParser.value(CL_OPTION_CONFIG),
+                .bbPath = clParser.value(CL_OPTION_BOX),
+                .binPath = {},
+                .precinctDir = {}
+            };
+        }
+        else if(clParser.isSet(CL_OPTION_CONFIG) && clParser.isSet(CL_OPTION_PRECINCTS))
+        {
+            mRefElectionCfg = ReferenceElectionConfig{
+                .ccPath = clParser.value(CL_OPTION_CONFIG),
+                .bbPath = {},
+                .binPath = {},
+                .precinctDir = clParser.value(CL_OPTION_PRECINCTS)
+            };
+        }
+        else
+            mRefElectionCfg = ReferenceElectionConfig{.ccPath = {}, .bbPath = {}, .binPath = clParser.value(CL_OPTION_BINARY_BOX), .precinctDir = {}};
 
         logElectionData(mRefElectionCfg.value());
 
+        // Handle binary conversion
+        if(clParser.isSet(CL_OPTION_SAVE_BINARY))
+        {
+            mBinarySavePath = clParser.value(CL_OPTION_SAVE_BINARY);
+            logEvent(NAME, LOG_EVENT_CONVERSION_MODE.arg(mBinarySavePath));
+        }
+
         // Handle calculator options
         QStringList selectedOpts;
         if(clParser.isSet(CL_OPTION_CALC_OPTIONS))
@@ -177,12 +222,40 @@ Qx::Error Core::initialize()
         QString optStr = !selectedOpts.isEmpty() ? selectedOpts.join(',') : ENUM_NAME(Star::Calculator::NoOptions);
         logEvent(NAME, LOG_EVENT_SELECTED_CALCULATOR_OPTIONS.arg(optStr));
 
+        // Handle thread count
+        if(clParser.isSet(CL_OPTION_THREADS))
+        {
+            bool validCount;
+            mThreadCount = clParser.value(CL_OPTION_THREADS).toInt(&validCount);
+            if(!validCount || mThreadCount < 1)
+            {
+                CoreError err(CoreError::InvalidThreadCount, clParser.value(CL_OPTION_THREADS));
+                postError(NAME, err);
+                return err;
+            }
+        }
+        logEvent(NAME, LOG_EVENT_THREAD_COUNT.arg(mThreadCount));
+
         // Handle minimal option
         if(clParser.isSet(CL_OPTION_MINIMAL))
         {
             mMinimal = true;
             logEvent(NAME, LOG_EVENT_MINIMAL_MODE);
         }
+
+        // Handle summarize option
+        if(clParser.isSet(CL_OPTION_SUMMARIZE) && !mRefElectionCfg->isBinary() && !mRefElectionCfg->isPrecincts())
+        {
+            mSummarize = true;
+            logEvent(NAME, LOG_EVENT_SUMMARY_MODE);
+        }
+
+        // Handle patterns option
+        if(clParser.isSet(CL_OPTION_PATTERNS) && !mRefElectionCfg->isBinary() && !mRefElectionCfg->isPrecincts())
+        {
+            mPatterns = true;
+            logEvent(NAME, LOG_EVENT_PATTERN_MODE);
+        }
     }
     else
     {
@@ -204,8 +277,18 @@ ReferenceElectionConfig Core::referenceElectionConfig() const
 
 Star::Calculator::Options Core::calculatorOptions() const { return mCalcOptions; }
 
+int Core::threadCount() const { return mThreadCount; }
+
 bool Core::isMinimalPresentation() const { return mMinimal; }
 
+bool Core::isSummaryMode() const { return mSummarize; }
+
+bool Core::isPatternInput() const { return mPatterns; }
+
+bool Core::isBinaryConversion() const { return !mBinarySavePath.isEmpty(); }
+
+QString Core::binarySavePath() const { return mBinarySavePath; }
+
 //-Signals & Slots------------------------------------------------------------------------------------------------------------
 //Public slots:
 void Core::logError(const QString& src, const Qx::Error& error)
@@ -30,7 +30,8 @@ public:
         NoError,
         LogError,
         InvalidArgs,
-        InvalidCalcOption
+        InvalidCalcOption,
+        InvalidThreadCount
     };
 
 //-Class Variables-------------------------------------------------------------
@@ -39,7 +40,8 @@ private:
         {NoError, u""_s},
         {LogError, u"Error writing to log"_s},
         {InvalidArgs, u"Invalid arguments provided."_s},
-        {InvalidCalcOption, u"Invalid calculator option provided."_s}
+        {InvalidCalcOption, u"Invalid calculator option provided."_s},
+        {InvalidThreadCount, u"Invalid thread count provided."_s}
     };
 
 //-Instance Variables-------------------------------------------------------------
@@ -72,7 +74,9 @@ class Core : public QObject
 private:
     // Error Messages
     static inline const QString ERR_LOG_ERROR = QStringLiteral("Error writing to log");
-    static inline const QString ERR_MISSING_REF_PATHS = QStringLiteral("Paths for both a category config and ballot box must be provided in order to calculate an election winner");
+    static inline const QString ERR_MISSING_REF_PATHS = QStringLiteral("Paths for both a category config and ballot box, a category config and precinct directory, or a binary ballot box, must be provided in order to calculate an election winner");
+    static inline const QString ERR_CONVERT_NEEDS_REF_PATHS = QStringLiteral("Paths for both a category config and ballot box must be provided in order to save a binary ballot box");
+    static inline const QString ERR_CONVERT_NEEDS_BALLOTS = QStringLiteral("A binary ballot box cannot be saved from summarized election data");
 
     // Logging - Primary
     static inline const QString LOG_FILE_EXT = QStringLiteral("log");
@@ -86,8 +90,14 @@ private:
     static inline const QString LOG_EVENT_VER_SHOWN = QStringLiteral("Displayed version information");
 
     static inline const QString LOG_EVENT_ELECTION_DATA_PROVIDED = QStringLiteral(R"(Election data provided: { .bbPath = "%1", .ccPath = "%2" })");
+    static inline const QString LOG_EVENT_BINARY_ELECTION_DATA_PROVIDED = QStringLiteral(R"(Binary election data provided: { .binPath = "%1" })");
+    static inline const QString LOG_EVENT_PRECINCT_ELECTION_DATA_PROVIDED = QStringLiteral(R"(Precinct election data provided: { .precinctDir = "%1", .ccPath = "%2" })");
+    static inline const QString LOG_EVENT_CONVERSION_MODE = QStringLiteral(R"(Saving election data as a binary ballot box to "%1" instead of calculating results.)");
     static inline const QString LOG_EVENT_SELECTED_CALCULATOR_OPTIONS = QStringLiteral("Selected calculator options: %1");
     static inline const QString LOG_EVENT_MINIMAL_MODE = QStringLiteral("Minimal presentation mode enabled.");
+    static inline const QString LOG_EVENT_THREAD_COUNT = QStringLiteral("Using %1 thread(s) for calculation.");
+    static inline const QString LOG_EVENT_SUMMARY_MODE = QStringLiteral("Summarizing ballots as they are read instead of keeping them.");
+    static inline const QString LOG_EVENT_PATTERN_MODE = QStringLiteral("Reading the ballot box as a pattern tally.");
 
     // Global command line option strings
     static inline const QString CL_OPT_HELP_S_NAME = QStringLiteral("h");
@@ -133,6 +143,30 @@ private:
     static inline const QString CL_OPT_MINIMAL_L_NAME = QStringLiteral("minimal");
     static inline const QString CL_OPT_MINIMAL_DESC = QStringLiteral("Only presents the results summary.");
 
+    static inline const QString CL_OPT_THREADS_S_NAME = QStringLiteral("t");
+    static inline const QString CL_OPT_THREADS_L_NAME = QStringLiteral("threads");
+    static inline const QString CL_OPT_THREADS_DESC = QStringLiteral("Number of threads to use when calculating results. Defaults to the ideal thread count of the system.");
+
+    static inline const QString CL_OPT_BINARY_BOX_S_NAME = QStringLiteral("B");
+    static inline const QString CL_OPT_BINARY_BOX_L_NAME = QStringLiteral("binary-box");
+    static inline const QString CL_OPT_BINARY_BOX_DESC = QStringLiteral("Specifies the path to a binary ballot box file to use instead of a category config and ballot box.");
+
+    static inline const QString CL_OPT_SAVE_BINARY_S_NAME = QStringLiteral("s");
+    static inline const QString CL_OPT_SAVE_BINARY_L_NAME = QStringLiteral("save-binary");
+    static inline const QString CL_OPT_SAVE_BINARY_DESC = QStringLiteral("Converts the provided category config and ballot box into a binary ballot box at the specified path instead of calculating results.");
+
+    static inline const QString CL_OPT_SUMMARIZE_S_NAME = QStringLiteral("S");
+    static inline const QString CL_OPT_SUMMARIZE_L_NAME = QStringLiteral("summarize");
+    static inline const QString CL_OPT_SUMMARIZE_DESC = QStringLiteral("Reduces each category of the provided ballot box to a summary while it is read instead of keeping every ballot, which greatly lowers memory use for large ballot boxes. Has no effect on binary ballot boxes.");
+
+    static inline const QString CL_OPT_PATTERNS_S_NAME = QStringLiteral("P");
+    static inline const QString CL_OPT_PATTERNS_L_NAME = QStringLiteral("patterns");
+    static inline const QString CL_OPT_PATTERNS_DESC = QStringLiteral("Reads the provided ballot box as a pattern tally, in which each row holds the scores given within one category along with the number of ballots that gave them, instead of one row per ballot. Has no effect on binary ballot boxes or precincts.");
+
+    static inline const QString CL_OPT_PRECINCTS_S_NAME = QStringLiteral("p");
+    static inline const QString CL_OPT_PRECINCTS_L_NAME = QStringLiteral("precincts");
+    static inline const QString CL_OPT_PRECINCTS_DESC = QStringLiteral("Specifies the path to a directory of precinct ballot box CSV files that share the category config, to use instead of a single ballot box. Precincts are summarized in parallel and each summary is saved next to its ballot box, so that only precincts that changed are read again on later runs.");
+
     // Global command line options
     static inline const QCommandLineOption CL_OPTION_HELP{{CL_OPT_HELP_S_NAME, CL_OPT_HELP_L_NAME, CL_OPT_HELP_E_NAME}, CL_OPT_HELP_DESC}; // Boolean option
     static inline const QCommandLineOption CL_OPTION_VERSION{{CL_OPT_VERSION_S_NAME, CL_OPT_VERSION_L_NAME}, CL_OPT_VERSION_DESC}; // Boolean option
@@ -140,9 +174,16 @@ private:
     static inline const QCommandLineOption CL_OPTION_BOX{{CL_OPT_BOX_S_NAME, CL_OPT_BOX_L_NAME}, CL_OPT_BOX_DESC, "box"}; // Takes value
     static inline const QCommandLineOption CL_OPTION_CALC_OPTIONS{{CL_OPT_CALC_OPTIONS_S_NAME, CL_OPT_CALC_OPTIONS_L_NAME}, CL_OPT_CALC_OPTIONS_DESC, "calc-options"}; // Takes value
     static inline const QCommandLineOption CL_OPTION_MINIMAL{{CL_OPT_MINIMAL_S_NAME, CL_OPT_MINIMAL_L_NAME}, CL_OPT_MINIMAL_DESC}; // Boolean option
+    static inline const QCommandLineOption CL_OPTION_THREADS{{CL_OPT_THREADS_S_NAME, CL_OPT_THREADS_L_NAME}, CL_OPT_THREADS_DESC, "threads"}; // Takes value
+    static inline const QCommandLineOption CL_OPTION_BINARY_BOX{{CL_OPT_BINARY_BOX_S_NAME, CL_OPT_BINARY_BOX_L_NAME}, CL_OPT_BINARY_BOX_DESC, "binary-box"}; // Takes value
+    static inline const QCommandLineOption CL_OPTION_SAVE_BINARY{{CL_OPT_SAVE_BINARY_S_NAME, CL_OPT_SAVE_BINARY_L_NAME}, CL_OPT_SAVE_BINARY_DESC, "save-binary"}; // Takes value
+    static inline const QCommandLineOption CL_OPTION_PRECINCTS{{CL_OPT_PRECINCTS_S_NAME, CL_OPT_PRECINCTS_L_NAME}, CL_OPT_PRECINCTS_DESC, "precincts"}; // Takes value
+    static inline const QCommandLineOption CL_OPTION_SUMMARIZE{{CL_OPT_SUMMARIZE_S_NAME, CL_OPT_SUMMARIZE_L_NAME}, CL_OPT_SUMMARIZE_DESC}; // Boolean option
+    static inline const QCommandLineOption CL_OPTION_PATTERNS{{CL_OPT_PATTERNS_S_NAME, CL_OPT_PATTERNS_L_NAME}, CL_OPT_PATTERNS_DESC}; // Boolean option
 
-    static inline const QList<const QCommandLineOption*> CL_OPTIONS_ALL{&CL_OPTION_HELP, &CL_OPTION_VERSION, &CL_OPTION_CONFIG, &CL_OPTION_BOX,
-                                                                        &CL_OPTION_MINIMAL, &CL_OPTION_CALC_OPTIONS};
+    static inline const QList<const QCommandLineOption*> CL_OPTIONS_ALL{&CL_OPTION_HELP, &CL_OPTION_VERSION, &CL_OPTION_CONFIG, &CL_OPTION_BOX, &CL_OPTION_PRECINCTS,
+                                                                        &CL_OPTION_BINARY_BOX, &CL_OPTION_SAVE_BINARY, &CL_OPTION_MINIMAL,
+                                                                        &CL_OPTION_CALC_OPTIONS, &CL_OPTION_THREADS, &CL_OPTION_SUMMARIZE, &CL_OPTION_PATTERNS};
 
     // Help template
     static inline const QString HELP_TEMPL = "Usage:\n"
@@ -170,9 +211,13 @@ private:
     // Processing
     QStringList mArguments;
     std::optional<ReferenceElectionConfig> mRefElectionCfg;
+    QString mBinarySavePath;
     Star::Calculator::Options mCalcOptions;
+    int mThreadCount;
 
     bool mMinimal;
+    bool mSummarize;
+    bool mPatterns;
 
 //-Constructor----------------------------------------------------------------------------------------------------------
 public:
@@ -191,7 +236,12 @@ public:
     bool hasActionableArguments() const;
     ReferenceElectionConfig referenceElectionConfig() const;
     Star::Calculator::Options calculatorOptions() const;
+    int threadCount() const;
     bool isMinimalPresentation() const;
+    bool isSummaryMode() const;
+    bool isPatternInput() const;
+    bool isBinaryConversion() const;
+    QString binarySavePath() const;
 
 //-Signals & Slots------------------------------------------------------------------------------------------------------------
 public slots:
@@ -14,16 +14,23 @@
 #include "core.h"
 #include "project_vars.h"
 #include "resultspresenter.h"
+#include "precincttabulator.h"
 
 // Log
 const QString LOG_EVENT_NO_ELECTION = QStringLiteral("No election data provided. Exiting...");
 const QString LOG_EVENT_LOADING_ELECTION = QStringLiteral("Loading reference election data.");
+const QString LOG_EVENT_LOADING_BINARY_ELECTION = QStringLiteral("Loading binary election data.");
+const QString LOG_EVENT_SUMMARIZING_ELECTION = QStringLiteral("Summarizing reference election data.");
+const QString LOG_EVENT_TABULATING_PRECINCTS = QStringLiteral("Tabulating precinct election data.");
+const QString LOG_EVENT_PRECINCT_COUNT = QStringLiteral("Combined %1 precincts, %2 of which were unchanged since they were last summarized.");
 const QString LOG_EVENT_ELECTION_COUNT = QStringLiteral("Loaded %1 elections.");
+const QString LOG_EVENT_SAVING_BINARY = QStringLiteral("Saving binary ballot box.");
 const QString LOG_EVENT_CALCULATING_RESULTS = QStringLiteral("Calculating results of all elections...");
 const QString LOG_EVENT_DISPLAYING_RESULTS = QStringLiteral("Displaying results...");
 
 // Msg
 const QString MSG_CALCULING_ELECTION_RESULTS = QStringLiteral("Calculating election results...");
+const QString MSG_BINARY_SAVED = QStringLiteral(R"(Saved %1 elections to binary ballot box "%2".)");
 
 // Meta
 const QString NAME = QStringLiteral("Main");
@@ -73,33 +80,84 @@ int main(int argc, char *argv[])
     }
 
     // Load reference election
-    core.logEvent(NAME, LOG_EVENT_LOADING_ELECTION);
     ReferenceElectionConfig rec = core.referenceElectionConfig();
 
     QList<Star::Election> elections;
-    Star::ReferenceError refError = Star::electionsFromReferenceInput(elections, rec.ccPath, rec.bbPath);
+    QList<Star::ElectionSummary> summaries; // Instead of elections in summary mode
+    Star::ReferenceError refError;
+    if(rec.isBinary())
+    {
+        core.logEvent(NAME, LOG_EVENT_LOADING_BINARY_ELECTION);
+        refError = Star::electionsFromBinaryInput(elections, rec.binPath);
+    }
+    else if(rec.isPrecincts())
+    {
+        core.logEvent(NAME, LOG_EVENT_TABULATING_PRECINCTS);
+        PrecinctTabulator tabulator(rec.ccPath, rec.precinctDir, core.threadCount());
+        refError = tabulator.tabulate(summaries);
+        if(!refError.isValid())
+            core.logEvent(NAME, LOG_EVENT_PRECINCT_COUNT.arg(tabulator.precinctCount()).arg(tabulator.reusedCount()));
+    }
+    else if(core.isSummaryMode())
+    {
+        core.logEvent(NAME, LOG_EVENT_SUMMARIZING_ELECTION);
+        refError = core.isPatternInput() ? Star::summariesFromPatternInput(summaries, rec.ccPath, rec.bbPath) :
+                                           Star::summariesFromReferenceInput(summaries, rec.ccPath, rec.bbPath);
+    }
+    else
+    {
+        core.logEvent(NAME, LOG_EVENT_LOADING_ELECTION);
+        refError = core.isPatternInput() ? Star::electionsFromPatternInput(elections, rec.ccPath, rec.bbPath) :
+                                           Star::electionsFromReferenceInput(elections, rec.ccPath, rec.bbPath);
+    }
+
     if(refError.isValid())
     {
         core.postError(NAME, refError);
         return core.logFinish(refError);
     }
-    core.logEvent(NAME, LOG_EVENT_ELECTION_COUNT.arg(elections.size()));
+    bool summarized = rec.isPrecincts() || core.isSummaryMode();
+    core.logEvent(NAME, LOG_EVENT_ELECTION_COUNT.arg(summarized ? summaries.size() : elections.size()));
+
+    // Convert to binary instead if requested
+    if(core.isBinaryConversion())
+    {
+        core.logEvent(NAME, LOG_EVENT_SAVING_BINARY);
+        refError = Star::electionsToBinaryOutput(elections, core.binarySavePath());
+        if(refError.isValid())
+        {
+            core.postError(NAME, refError);
+            return core.logFinish(refError);
+        }
+
+        core.postMessage(MSG_BINARY_SAVED.arg(elections.size()).arg(core.binarySavePath()));
+        return core.logFinish(Qx::Error());
+    }
 
     // Create calculator
     Star::Calculator calculator;
     calculator.setOptions(core.calculatorOptions());
+    calculator.setThreadCount(core.threadCount());
     QObject::connect(&calculator, &Star::Calculator::calculationDetail, &core, &Core::logCalculatorDetail);
 
-    // Result container
-    QList<Star::ElectionResult> results;
-
-    // Calculate the results of each election
+    // Calculate the results of all elections
     core.logEvent(NAME, LOG_EVENT_CALCULATING_RESULTS);
     core.postMessage(MSG_CALCULING_ELECTION_RESULTS + '\n');
-    for(const Star::Election& election : elections)
+
+    QList<Star::ElectionResult> results;
+    if(summarized)
     {
-        calculator.setElection(&election);
-        results.append(calculator.calculateResult());
+        // Summaries are cheap to evaluate regardless of ballot count, so they're simply done in turn
+        for(const Star::ElectionSummary& summary : std::as_const(summaries))
+            results.append(calculator.calculateResult(summary));
+    }
+    else
+    {
+        QList<const Star::Election*> electionPtrs;
+        for(const Star::Election& election : std::as_const(elections))
+            electionPtrs.append(&election);
+
+        results = calculator.calculateResults(electionPtrs);
     }
 
     // Display results
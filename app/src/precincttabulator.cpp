@@ -0,0 +1,133 @@
+// Unit Include
+#include "precincttabulator.h"
+
+// Standard Library Includes
+#include <algorithm>
+
+// Qt Includes
+#include <QDir>
+#include <QFileInfo>
+#include <QThreadPool>
+
+//===============================================================================================================
+// PrecinctTabulator
+//===============================================================================================================
+
+//-Constructor-------------------------------------------------------------
+PrecinctTabulator::PrecinctTabulator(const QString& categoryConfigPath, const QString& precinctDir, int threadCount) :
+    mCategoryConfigPath(categoryConfigPath),
+    mPrecinctDir(precinctDir),
+    mThreadCount(threadCount),
+    mReusedCount(0)
+{}
+
+//-Class Functions-------------------------------------------------------------
+//Private:
+QString PrecinctTabulator::summaryPath(const QString& precinctPath) { return precinctPath + SUMMARY_EXT; }
+
+//-Instance Functions-------------------------------------------------------------
+//Private:
+bool PrecinctTabulator::hasCurrentSummary(const QString& precinctPath) const
+{
+    // A saved summary is only still valid if neither its precinct nor the shared config changed since
+    QFileInfo summaryInfo(summaryPath(precinctPath));
+    if(!summaryInfo.exists())
+        return false;
+
+    QDateTime summaryTime = summaryInfo.lastModified();
+    return summaryTime >= QFileInfo(precinctPath).lastModified() &&
+           summaryTime >= QFileInfo(mCategoryConfigPath).lastModified();
+}
+
+Star::ReferenceError PrecinctTabulator::summarizePrecinct(QList<Star::ElectionSummary>& returnBuffer, const QString& precinctPath, bool& reused) const
+{
+    // Reuse the saved summary if possible, falling back to the ballot box if it can't be read
+    reused = hasCurrentSummary(precinctPath) && !Star::summariesFromBinaryInput(returnBuffer, summaryPath(precinctPath)).isValid();
+    if(reused)
+        return Star::ReferenceError();
+
+    Star::ReferenceError refError = Star::summariesFromReferenceInput(returnBuffer, mCategoryConfigPath, precinctPath);
+    if(refError.isValid())
+        return refError;
+
+    return Star::summariesToBinaryOutput(returnBuffer, summaryPath(precinctPath));
+}
+
+//Public:
+qsizetype PrecinctTabulator::precinctCount() const { return mPrecinctPaths.size(); }
+qsizetype PrecinctTabulator::reusedCount() const { return mReusedCount; }
+
+Star::ReferenceError PrecinctTabulator::tabulate(QList<Star::ElectionSummary>& returnBuffer)
+{
+    // Clear return buffer
+    returnBuffer.clear();
+
+    // Find precincts
+    mPrecinctPaths.clear();
+    mReusedCount = 0;
+
+    QDir dir(mPrecinctDir);
+    const QFileInfoList precinctFiles = dir.entryInfoList({BALLOT_BOX_FILTER}, QDir::Files, QDir::Name);
+    for(const QFileInfo& precinctFile : precinctFiles)
+        mPrecinctPaths.append(precinctFile.filePath());
+
+    if(mPrecinctPaths.isEmpty())
+    {
+        return Star::ReferenceError{
+            .type = Star::ReferenceErrorType::BallotBox,
+            .error = ERR_NO_PRECINCTS,
+            .errorDetails = ERR_NO_PRECINCTS_DETAILS.arg(mPrecinctDir)
+        };
+    }
+
+    // Summarize each precinct independently
+    qsizetype precinctCount = mPrecinctPaths.size();
+    QList<QList<Star::ElectionSummary>> partials(precinctCount);
+    QList<Star::ReferenceError> errors(precinctCount);
+    QList<char> reused(precinctCount, false);
+    QList<Star::ElectionSummary>* partialData = partials.data();
+    Star::ReferenceError* errorData = errors.data();
+    char* reusedData = reused.data();
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(mThreadCount);
+
+    for(qsizetype i = 0; i < precinctCount; i++)
+    {
+        QString precinctPath = mPrecinctPaths.at(i);
+        pool.start([=, this]{
+            bool precinctReused;
+            errorData[i] = summarizePrecinct(partialData[i], precinctPath, precinctReused);
+            reusedData[i] = precinctReused;
+        });
+    }
+
+    pool.waitForDone();
+
+    // Report the first failure in precinct order
+    for(Star::ReferenceError& error : errors)
+        if(error.isValid())
+            return error;
+
+    mReusedCount = std::count(reused.cbegin(), reused.cend(), true);
+
+    /* Combine the precincts category by category. Every precinct shares the same category config, so the
+     * categories line up by position.
+     */
+    QList<Star::ElectionSummary::Builder> builders;
+    for(const QList<Star::ElectionSummary>& partial : std::as_const(partials))
+    {
+        for(qsizetype c = 0; c < partial.size(); c++)
+        {
+            if(c == builders.size())
+                builders.emplace_back(partial.at(c).name());
+
+            builders[c].wSummary(partial.at(c));
+        }
+    }
+
+    for(Star::ElectionSummary::Builder& builder : builders)
+        returnBuffer.append(builder.build());
+
+    return Star::ReferenceError();
+}
@@ -0,0 +1,51 @@
+#ifndef PRECINCTTABULATOR_H
+#define PRECINCTTABULATOR_H
+
+// Qt Includes
+#include <QString>
+#include <QStringList>
+
+// Base Includes
+#include "star/electionsummary.h"
+#include "star/reference.h"
+
+class PrecinctTabulator
+{
+//-Class Variables------------------------------------------------------------------------------------------------------
+private:
+    // Files
+    static inline const QString BALLOT_BOX_FILTER = QStringLiteral("*.csv");
+    static inline const QString SUMMARY_EXT = QStringLiteral(".sts");
+
+    // Errors
+    static inline const QString ERR_NO_PRECINCTS = QStringLiteral("Error reading the precinct ballot boxes.");
+    static inline const QString ERR_NO_PRECINCTS_DETAILS = QStringLiteral(R"(No ballot boxes were found in "%1".)");
+
+//-Instance Variables------------------------------------------------------------------------------------------------------
+private:
+    QString mCategoryConfigPath;
+    QString mPrecinctDir;
+    int mThreadCount;
+    QStringList mPrecinctPaths;
+    qsizetype mReusedCount;
+
+//-Constructor----------------------------------------------------------------------------------------------------------
+public:
+    PrecinctTabulator(const QString& categoryConfigPath, const QString& precinctDir, int threadCount);
+
+//-Class Functions------------------------------------------------------------------------------------------------------
+private:
+    static QString summaryPath(const QString& precinctPath);
+
+//-Instance Functions------------------------------------------------------------------------------------------------------
+private:
+    bool hasCurrentSummary(const QString& precinctPath) const;
+    Star::ReferenceError summarizePrecinct(QList<Star::ElectionSummary>& returnBuffer, const QString& precinctPath, bool& reused) const;
+
+public:
+    qsizetype precinctCount() const;
+    qsizetype reusedCount() const;
+    Star::ReferenceError tabulate(QList<Star::ElectionSummary>& returnBuffer);
+};
+
+#endif // PRECINCTTABULATOR_H
@@ -8,6 +8,11 @@ struct ReferenceElectionConfig
 {
     QString ccPath;
     QString bbPath;
+    QString binPath;
+    QString precinctDir; // Used with ccPath instead of bbPath
+
+    bool isBinary() const { return !binPath.isEmpty(); }
+    bool isPrecincts() const { return !precinctDir.isEmpty(); }
 };
 
 #endif // REFERENCE_ELECTION_CONFIG_H
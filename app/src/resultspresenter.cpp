@@ -40,8 +40,8 @@ void ResultPresenter::pause()
 
 void ResultPresenter::printElectionResult(const Star::ElectionResult& result)
 {
-    QString category = result.election()->name();
-    QStringList candidates = result.election()->candidates();
+    QString category = result.summary().name();
+    QStringList candidates = result.summary().candidates();
     // Print category
     cout << HEADING_CATEGORY.arg(category) << endl << endl;
 
@@ -72,7 +72,7 @@ void ResultPresenter::printElectionResult(const Star::ElectionResult& result)
 
     // Print raw score rankings
     cout << HEADING_SCORE_RANKINGS << endl;
-    for(const Star::Rank& rank : result.election()->scoreRankings())
+    for(const Star::Rank& rank : result.summary().scoreRankings())
         cout << RAW_SCORE_TEMPLATE.arg(Qx::String::join(rank.candidates, R"(", ")")).arg(rank.value) << endl;
     cout << endl;
 
@@ -105,7 +105,7 @@ void ResultPresenter::printSummary()
     auto getSeatText = [&](const Star::ElectionResult& r, qsizetype s){
         if(r.filledSeatCount() > s)
             return '"' + r.winners().at(s) + '"';
-        else if(s >= r.election()->seatCount())
+        else if(s >= r.summary().seatCount())
             return SUMMARY_BLANK_FIELD;
         else
             return SUMMARY_UNRESOLVED_FIELD;
@@ -118,7 +118,7 @@ void ResultPresenter::printSummary()
         const Star::ElectionResult& result = mResults->at(res);
 
         // Category, winner, runner-up
-        summaryTable.at(row, 0) = ' ' + result.election()->name() + ' ';
+        summaryTable.at(row, 0) = ' ' + result.summary().name() + ' ';
         summaryTable.at(row, 1) = SUMMARY_LIST_ITEM.arg(getSeatText(result, 0));
         summaryTable.at(row, 2) = SUMMARY_LIST_ITEM.arg(getSeatText(result, 1));
     }
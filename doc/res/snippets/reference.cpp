@@ -5,6 +5,16 @@ X,Sarah,5,2,2,1,4
 X,Ted,3,0,0,5,0
 //! [Input Format CSV]
 
+//! [Input Format Pattern CSV]
+N/A,Count,CatACan1,CatACan2,CatACan3,CatBCan1,CatBCan2
+Category A,1,0,3,5
+Category B,1,4,2
+Category A,1,5,2,2
+Category A,41,3,0,0
+Category B,21,1,4
+Category B,21,5,0
+//! [Input Format Pattern CSV]
+
 //! [Input Format INI]
 [Categories]
 Category A = 3
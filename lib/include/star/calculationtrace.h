@@ -0,0 +1,231 @@
+#ifndef CALCULATIONTRACE_H
+#define CALCULATIONTRACE_H
+
+// Shared Library Support
+#include "star/star_base_export.h"
+
+// Standard Library Includes
+#include <span>
+
+// Qt Includes
+#include <QString>
+#include <QStringList>
+#include <QList>
+
+namespace Star
+{
+
+class STAR_BASE_EXPORT CalculationTrace
+{
+    friend class Calculator;
+//-Class Enums------------------------------------------------------------------------------------------------------
+public:
+    enum Kind
+    {
+        // Intro
+        InvalidElection,
+        CalculationStart,
+        InputCounts,
+        InitialScoreRankings,
+        HeadToHeadPrecalculation,
+
+        // Runoff Qualifier
+        Qualifier,
+        QualifierTop,
+        AdvanceCandidates,
+        CutCandidates,
+        QualifierNoRandom,
+        QualifierUnsuccessful,
+        QualifierResult,
+
+        // Defacto Winner Check
+        DefactoWinnerCheck,
+        DefactoWinnerCheckWin,
+        DefactoWinnerCheckFail,
+        DefactoWinnerCheckSuccess,
+
+        // Runoff
+        Runoff,
+        RunoffHeadToHeadWinnerCheck,
+        RunoffTie,
+        RunoffHigherScoreCheck,
+        RunoffMoreFiveStarCheck,
+        RunoffChoosingRandomWinner,
+        RunoffNoRandom,
+        RunoffWinner,
+        RunoffUnresolved,
+
+        // Ranking
+        RankByScore,
+        ScoreRankings,
+        RankByVotesOfMaxScore,
+        VotesOfMaxScoreRankings,
+        RankByHeadToHeadLosses,
+        HeadToHeadLossesRankings,
+        RankByHeadToHeadPreferences,
+        HeadToHeadPreferencesRankings,
+        RankByHeadToHeadMargin,
+        HeadToHeadMarginRankings,
+
+        // Tiebreak
+        BreakTieMostFiveStar,
+        BreakTieHighestScore,
+        BreakTieRandom,
+        BreakResult,
+
+        // Main
+        FillingSeat,
+        DirectSeatFill,
+        RunoffCandidates,
+        NoRunoff,
+        DefactoWinnerSeatFill,
+        PrimaryRunoff,
+
+        // Finish
+        FinalResults,
+        CalculationFinish
+    };
+
+//-Inner Structs----------------------------------------------------------------------------------------------------
+public:
+    struct Event
+    {
+        Kind kind;
+        std::span<const qint32> data;
+    };
+
+private:
+    struct Record
+    {
+        Kind kind;
+        qsizetype offset;
+        qsizetype length;
+    };
+
+//-Class Variables------------------------------------------------------------------------------------------------------
+private:
+    // Initial capacity
+    static inline const qsizetype RESERVED_EVENTS = 256;
+    static inline const qsizetype RESERVED_DATA = 4096;
+
+    // Intro
+    static inline const QString TEXT_INVALID_ELECTION = QStringLiteral("The provided election is invalid.");
+    static inline const QString TEXT_CALC_START = QStringLiteral("Calculating results of election - %1");
+    static inline const QString TEXT_INPUT_COUNTS = QStringLiteral("There are %1 candidates, %2 ballots, and %3 seats to fill.");
+    static inline const QString TEXT_INITAL_RAW_RANKINGS = QStringLiteral("Initial score rankings:");
+    static inline const QString TEXT_CALC_HEAD_TO_HEAD = QStringLiteral("Preparing head-to-head matchup results...");
+
+    // Perform Runoff Qualifier
+    static inline const QString TEXT_QUALIFIER = QStringLiteral("Performing runoff qualifier to seed candidates for the runoff.");
+    static inline const QString TEXT_QUALIFIER_TOP = QStringLiteral("Trying to determine remaining %1 candidate(s) to advance between:");
+    static inline const QString TEXT_QUALIFIER_ADVANCE_CANDIDATES = QStringLiteral("Advancing candidate(s):");
+    static inline const QString TEXT_QUALIFIER_CUT_CANDIDATES = QStringLiteral("Cutting candidate(s):");
+    static inline const QString TEXT_QUALIFIER_NO_RANDOM = QStringLiteral("Random tiebreaker is disabled.");
+    static inline const QString TEXT_QUALIFIER_UNSUCCESSFUL = QStringLiteral("Unable to resolve scoring round tie to reach the target number of candidates.");
+    static inline const QString TEXT_QUALIFIER_RESULT = QStringLiteral(
+        "Qualifier Result:\n"
+        "First Seed: %1\n"
+        "Second Seed: %2\n"
+        "Simultaneous: %3\n"
+        "Overflow: {%4}\n"
+    );
+
+    // Defacto Winner Check
+    static inline const QString TEXT_DEFACTO_WINNER_CHECK = QStringLiteral(R"(Simulating runoff for potential defacto winner "%1" between:)");
+    static inline const QString TEXT_DEFACTO_WINNER_CHECK_WIN = QStringLiteral(R"(The first seed won against "%1".)");
+    static inline const QString TEXT_DEFACTO_WINNER_CHECK_FAIL = QStringLiteral(R"(The first seed lost to "%1".)");
+    static inline const QString TEXT_DEFACTO_WINNER_CHECK_SUCCESS = QStringLiteral("The first seed wins all simulated runoffs.");
+
+    // Runoff
+    static inline const QString TEXT_RUNOFF = QStringLiteral(R"(Observing runoff between "%1" and "%2".)");
+    static inline const QString TEXT_RUNOFF_HEAD_TO_HEAD_WINNER_CHECK = QStringLiteral("Checking for clear winner of head-to-head.");
+    static inline const QString TEXT_RUNOFF_TIE = QStringLiteral("The candidates in the runoff are tied in terms of preference.");
+    static inline const QString TEXT_RUNOFF_HIGHER_SCORE_CHECK = QStringLiteral("Checking for the candidate with the higher score.");
+    static inline const QString TEXT_RUNOFF_MORE_FIVE_STAR_CHECK = QStringLiteral("Checking for the candidate with more five star votes.");
+    static inline const QString TEXT_RUNOFF_CHOOSING_RANDOM_WINNER = QStringLiteral("Choosing runoff winner randomly.");
+    static inline const QString TEXT_RUNOFF_NO_RANDOM = QStringLiteral("Random tiebreaker is disabled, the runoff candidates remained tied.");
+    static inline const QString TEXT_RUNOFF_WINNER = QStringLiteral(R"(The runoff resulted in a win for: "%1")");
+    static inline const QString TEXT_RUNOFF_UNRESOLVED = QStringLiteral("The runoff tie could not be broken.");
+
+    // Ranking
+    static inline const QString TEXT_RANK_BY_SCORE = QStringLiteral("Ranking relevant candidates by score (%1)...");
+    static inline const QString TEXT_RANKINGS_SCORE = QStringLiteral("Score rankings:");
+    static inline const QString TEXT_RANK_BY_VOTES_OF_MAX_SCORE = QStringLiteral("Ranking relevant candidates by votes of max score (%1)...");
+    static inline const QString TEXT_RANKINGS_VOTES_OF_MAX_SCORE = QStringLiteral("Votes of Max Score rankings:");
+    static inline const QString TEXT_RANK_BY_HEAD_TO_HEAD_LOSSES = QStringLiteral("Ranking relevant candidates by head-to-head losses (%1)...");
+    static inline const QString TEXT_RANKINGS_HEAD_TO_HEAD_LOSSES = QStringLiteral("Head-to-head losses rankings:");
+    static inline const QString TEXT_RANK_BY_HEAD_TO_HEAD_PREFERENCES = QStringLiteral("Ranking relevant candidates by head-to-head preference count (%1)...");
+    static inline const QString TEXT_RANKINGS_HEAD_TO_HEAD_PREFERENCES = QStringLiteral("Head-to-head preference count rankings:");
+    static inline const QString TEXT_RANK_BY_HEAD_TO_HEAD_MARGIN = QStringLiteral("Ranking relevant candidates by head-to-head margin (%1)...");
+    static inline const QString TEXT_RANKINGS_HEAD_TO_HEAD_MARGIN = QStringLiteral("Head-to-head margin rankings:");
+
+    // Tiebreak
+    static inline const QString TEXT_BREAK_TIE_MOST_FIVE_STAR = QStringLiteral("Breaking %1-way tie according to most five star votes...");
+    static inline const QString TEXT_BREAK_TIE_HIGHEST_SCORE = QStringLiteral("Breaking %1-way tie according to highest score...");
+    static inline const QString TEXT_BREAK_TIE_RANDOM = QStringLiteral("Breaking %1-way tie randomly...");
+    static inline const QString TEXT_BREAK_RESULT = QStringLiteral("Tie Break Winner(s) - { %1 }");
+
+    // Main
+    static inline const QString TEXT_FILLING_SEAT = QStringLiteral("Filling seat %1...");
+    static inline const QString TEXT_DIRECT_SEAT_FILL = QStringLiteral("Only one candidate remains, seat can be filled directly.");
+    static inline const QString TEXT_RUNOFF_CANDIDATES = QStringLiteral(R"("%1" & "%2" advance to the runoff.)");
+    static inline const QString TEXT_NO_RUNOFF = QStringLiteral("The number of candidates could not be narrowed to two in order to perform the runoff.");
+    static inline const QString TEXT_DEFACTO_WINNER_SEAT_FILL = QStringLiteral(R"(Filling seat with defacto winner "%1")");
+    static inline const QString TEXT_PERFORM_PRIMARY_RUNOFF = QStringLiteral("Performing primary runoff...");
+
+    // Final Results
+    static inline const QString TEXT_FINAL_RESULTS = QStringLiteral(
+        "Final Results:\n"
+        "\n"
+        "Filled Seats:\n"
+        "%1"
+        "\n"
+        "Unresolved Candidates:\n"
+        "%2"
+        "\n"
+        "Unfilled Seats: %3\n"
+    );
+
+    // Finish
+    static inline const QString TEXT_CALC_FINISH = QStringLiteral("Calculation complete.");
+
+    // Lists
+    static inline const QString LIST_ITEM_RANK = QStringLiteral("\t%1) { \"%2\" } <%3>");
+    static inline const QString LIST_ITEM_SEAT = QStringLiteral("\t%1) \"%2\"");
+    static inline const QString LIST_ITEM_UNRESOLVED = QStringLiteral("\t- \"%1\"");
+    static inline const QString LIST_ITEM_NONE = QStringLiteral("\t *NONE*");
+
+//-Instance Variables--------------------------------------------------------------------------------------------------
+private:
+    QString mElectionName;
+    QStringList mCandidates;
+    QList<Record> mRecords;
+    QList<qint32> mData;
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+public:
+    CalculationTrace();
+
+//-Instance Functions-------------------------------------------------------------------------------------------------
+private:
+    void reset(const QString& electionName, const QStringList& candidates);
+    void beginEvent(Kind kind);
+    void appendValue(qint32 value);
+    void endEvent();
+
+public:
+    bool isEmpty() const;
+    qsizetype count() const;
+    QString electionName() const;
+    QStringList candidates() const;
+
+    Event event(qsizetype i) const;
+    QList<qsizetype> find(Kind kind) const;
+
+    QString render(qsizetype i) const;
+    QStringList render() const;
+};
+
+}
+
+#endif // CALCULATIONTRACE_H
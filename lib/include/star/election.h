@@ -4,10 +4,16 @@
 // Shared Library Support
 #include "star/star_base_export.h"
 
+// Standard Library Includes
+#include <span>
+#include <array>
+#include <memory>
+
 // Qt Includes
 #include "qdatetime.h"
 #include <QString>
 #include <QList>
+#include <QHash>
 
 // Project Includes
 #include "star/rank.h"
@@ -15,38 +21,97 @@
 namespace Star
 {
 
+// Forward Declarations
+class PreferenceMatrix;
+class ElectionSummary;
+
 class STAR_BASE_EXPORT Election
 {
+//-Class Enums------------------------------------------------------------------------------------------------------
+public:
+    enum ScoreLayout { Bytes, BitPlanes, Sparse };
+
 //-Inner Classes----------------------------------------------------------------------------------------------------
 public:
     struct Vote;
     struct Voter;
+    struct ScoreStatistics;
+    struct SparseScore;
     class Ballot;
     class Builder;
 
+//-Class Variables------------------------------------------------------------------------------------------------------
+private:
+    static const qsizetype MIN_LIVE_STRIDE = 1024;
+    static const int PLANE_COUNT = 3; // Enough bits for every score
+    static const qsizetype PLANE_WIDTH = 64; // Ballots per word
+
 //-Instance Variables--------------------------------------------------------------------------------------------------
 private:
     QString mName;
-    QList<Ballot> mBallots;
+    QStringList mCandidates;
+    QHash<QString, int> mCandidateIds;
+    QList<Voter> mVoters;
+    QList<int> mWeights; // Per ballot, empty while every ballot has a weight of 1
+    qsizetype mTotalWeight;
+    ScoreLayout mScoreLayout;
+    QList<quint8> mScores; // Candidate-major, i.e. [c * mScoreStride + b]
+    QList<quint64> mScorePlanes; // Candidate-major, with each word group holding bit 0-2 of 64 ballots' scores
+    qsizetype mScoreStride; // Room for each candidate's scores, at least ballotCount() and a multiple of 64 for planes
+    QList<SparseScore> mSparseScores; // Ballot-major nonzero scores, with each ballot's ordered by candidate
+    QList<qsizetype> mSparseOffsets; // Where each ballot's nonzero scores start within mSparseScores
+    QList<int> mSparseCounts; // How many nonzero scores each ballot has
+    qsizetype mSparseGarbage; // Entries of mSparseScores no longer used by any ballot
     int mSeats;
-    QMap<QString, int> mTotals;
+    QList<ScoreStatistics> mStatistics;
     QList<Rank> mScoreRankings;
+    std::shared_ptr<PreferenceMatrix> mLiveMatrix; // Only kept once enableLiveTally() is used
 
 //-Constructor---------------------------------------------------------------------------------------------------------
 public:
     Election();
 
 //-Instance Functions-------------------------------------------------------------------------------------------------
+private:
+    void growScores(qsizetype stride);
+    quint8 storedScore(qsizetype id, qsizetype ballot) const;
+    void storeScore(qsizetype id, qsizetype ballot, quint8 score);
+    void compactSparseScores();
+    void rankScores();
+    PreferenceMatrix& liveMatrix();
+
 public:
     bool isValid() const;
 
     QString name() const;
     QStringList candidates() const;
-    const QList<Ballot>& ballots() const;
+    qsizetype candidateCount() const;
+    int candidateId(const QString& candidate) const;
+    QString candidateName(int id) const;
+    QList<Ballot> ballots() const;
+    Ballot ballotAt(qsizetype i) const;
+    qsizetype ballotCount() const;
+    bool isWeighted() const;
+    int ballotWeight(qsizetype i) const;
+    std::span<const int> weights() const;
+    qsizetype totalWeight() const;
     int seatCount() const;
 
+    ScoreLayout scoreLayout() const;
+    int score(int candidateId, qsizetype ballot) const;
+    std::span<const quint8> scores(int candidateId) const;
+    std::span<const quint64> scorePlanes(int candidateId) const;
+    std::span<const SparseScore> sparseScores(qsizetype ballot) const;
     int totalScore(const QString& candidate) const;
+    int totalScore(int candidateId) const;
+    const ScoreStatistics& statistics(int candidateId) const;
     const QList<Rank>& scoreRankings() const;
+    ElectionSummary summary() const;
+
+    bool hasLiveTally() const;
+    void enableLiveTally(int threadCount = 1);
+    void appendBallot(const Voter& voter, std::span<const quint8> scores, int weight = 1);
+    void retractBallot(qsizetype index);
 };
 
 struct Election::Voter
@@ -55,6 +120,24 @@ struct Election::Voter
     QString anonymousName;
 };
 
+struct Election::SparseScore
+{
+    int candidateId;
+    quint8 score;
+};
+
+struct STAR_BASE_EXPORT Election::ScoreStatistics
+{
+    static constexpr int MAX_SCORE = 5;
+
+    std::array<int, MAX_SCORE + 1> scoreCounts = {};
+
+    int count(int score) const;
+    int ballotCount() const;
+    int totalScore() const;
+    double averageScore() const;
+};
+
 struct Election::Vote
 {
     QString candidate;
@@ -63,21 +146,23 @@ struct Election::Vote
 
 class STAR_BASE_EXPORT Election::Ballot
 {
-    friend class Election::Builder;
+    friend class Election;
 //-Instance Variables--------------------------------------------------------------------------------------------------
 private:
-    Voter mVoter;
-    QHash<QString, int> mVotes;
+    const Election* mElection;
+    qsizetype mIndex;
 
 //-Constructor--------------------------------------------------------------------------------------------------------
 private:
-    Ballot();
+    Ballot(const Election* election, qsizetype index);
 
 //-Instance Functions-------------------------------------------------------------------------------------------------
 public:
     const Voter& voter() const;
+    int weight() const;
 
     int score(const QString& candidate) const;
+    int score(int candidateId) const;
     QString preference(const QString& candidateA, const QString& candidateB) const;
 };
 
@@ -87,15 +172,52 @@ class STAR_BASE_EXPORT Election::Builder
 private:
     Election mConstruct;
 
+    // Scores are staged per candidate in order of first appearance until build()
+    QHash<QString, int> mArrivalIds;
+    QStringList mArrivalCandidates;
+    QList<QList<quint8>> mArrivalScores; // Unused for the sparse layout
+    QList<SparseScore> mArrivalEntries; // Sparse layout only, ballot-major and ordered by arrival ID within each ballot
+    QList<qsizetype> mArrivalOffsets; // Sparse layout only, where each ballot's entries start
+    QList<ScoreStatistics> mArrivalStatistics;
+    QList<int> mArrivalWeights; // Empty until a ballot with a weight other than 1 is added
+    ScoreLayout mScoreLayout;
+    qsizetype mBallotCount;
+    qsizetype mTotalWeight;
+    qsizetype mReservedBallots;
+    bool mCollapseDuplicates;
+
 //-Constructor---------------------------------------------------------------------------------------------------------
 public:
     Builder(const QString& name = QString());
 
 //-Instance Functions-------------------------------------------------------------------------------------------------
+private:
+    int registerCandidate(const QString& candidate);
+    void recordVotes(const QList<Vote>& votes, int weight);
+    void recordScores(std::span<const quint8> scores, int weight);
+    void recordWeight(int weight);
+    qsizetype arrivalEntriesEnd(qsizetype ballot) const;
+    void settleZeroCounts();
+    void restage(ScoreLayout layout);
+    void prepareVoter();
+    void fitVoters(qsizetype count);
+    void collapseDuplicates();
+
 public:
+    Builder& reserve(qsizetype ballots, qsizetype candidates);
     Builder& wName(const QString& name);
-    Builder& wBallot(const Voter& voter, const QList<Vote>& votes);
+    Builder& wCandidates(const QStringList& candidates);
+    Builder& wBallot(const Voter& voter, const QList<Vote>& votes, int weight = 1);
+    Builder& wBallot(Voter&& voter, const QList<Vote>& votes, int weight = 1);
+    Builder& wBallot(const Voter& voter, std::span<const quint8> scores, int weight = 1);
+    Builder& wBallot(Voter&& voter, std::span<const quint8> scores, int weight = 1);
+    Builder& wBallot(std::span<const quint8> scores, int weight = 1);
+    Builder& wBallots(const QList<Voter>& voters, const QStringList& candidates, std::span<const quint8> scores,
+                      std::span<const int> weights = {});
+    Builder& wVoters(const QList<Voter>& voters);
     Builder& wSeatCount(int count);
+    Builder& wCollapseDuplicates(bool collapse);
+    Builder& wScoreLayout(ScoreLayout layout);
     void reset();
     Election build();
 };
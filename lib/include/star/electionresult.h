@@ -6,6 +6,7 @@
 
 // Project Includes
 #include "star/election.h"
+#include "star/electionsummary.h"
 #include "star/seat.h"
 
 namespace Star
@@ -16,12 +17,14 @@ class STAR_BASE_EXPORT ElectionResult
 //-Instance Variables--------------------------------------------------------------------------------------------------
 private:
     const Election* mElection;
+    ElectionSummary mSummary;
     QList<Seat> mSeats;
 
 //-Constructor---------------------------------------------------------------------------------------------------------
 public:
     ElectionResult();
     ElectionResult(const Election* election, const QList<Seat>& seats);
+    ElectionResult(const ElectionSummary& summary, const QList<Seat>& seats);
 
 //-Instance Functions-------------------------------------------------------------------------------------------------
 public:
@@ -37,6 +40,7 @@ public:
     qsizetype filledSeatCount() const;
     qsizetype unfilledSeatCount() const;
     const Election* election() const;
+    const ElectionSummary& summary() const;
 
     bool operator==(const ElectionResult& other) const;
     bool operator!=(const ElectionResult& other) const;
@@ -0,0 +1,99 @@
+#ifndef ELECTIONSUMMARY_H
+#define ELECTIONSUMMARY_H
+
+// Shared Library Support
+#include "star/star_base_export.h"
+
+// Standard Library Includes
+#include <span>
+#include <memory>
+
+// Qt Includes
+#include <QString>
+#include <QList>
+#include <QHash>
+
+// Project Includes
+#include "star/election.h"
+
+namespace Star
+{
+
+// Forward Declarations
+class PreferenceMatrix;
+
+class STAR_BASE_EXPORT ElectionSummary
+{
+    friend class Election;
+    friend class HeadToHeadResults;
+//-Inner Classes----------------------------------------------------------------------------------------------------
+public:
+    class Builder;
+
+//-Instance Variables--------------------------------------------------------------------------------------------------
+private:
+    QString mName;
+    QStringList mCandidates;
+    QHash<QString, int> mCandidateIds;
+    int mSeats;
+    qsizetype mBallotCount;
+    QList<Election::ScoreStatistics> mStatistics;
+    QList<Rank> mScoreRankings;
+    std::shared_ptr<const PreferenceMatrix> mPreferences;
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+public:
+    ElectionSummary();
+
+//-Instance Functions-------------------------------------------------------------------------------------------------
+public:
+    bool isNull() const;
+    bool isValid() const;
+
+    QString name() const;
+    QStringList candidates() const;
+    qsizetype candidateCount() const;
+    int candidateId(const QString& candidate) const;
+    QString candidateName(int id) const;
+    qsizetype ballotCount() const;
+    int seatCount() const;
+
+    int totalScore(int candidateId) const;
+    const Election::ScoreStatistics& statistics(int candidateId) const;
+    const QList<Rank>& scoreRankings() const;
+
+    bool hasPreferences() const;
+    int preferences(int candidateA, int candidateB) const;
+};
+
+class STAR_BASE_EXPORT ElectionSummary::Builder
+{
+//-Instance Variables--------------------------------------------------------------------------------------------------
+private:
+    ElectionSummary mConstruct;
+
+    // Tallies are kept in order of candidate registration until build()
+    QStringList mArrivalCandidates;
+    QList<Election::ScoreStatistics> mArrivalStatistics;
+    QList<int> mArrivalPreferences; // [a * candidates + b] = Ballots that prefer a over b
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+public:
+    Builder(const QString& name = QString());
+
+//-Instance Functions-------------------------------------------------------------------------------------------------
+public:
+    Builder& wName(const QString& name);
+    Builder& wCandidates(const QStringList& candidates);
+    Builder& wSeatCount(int count);
+    Builder& wBallot(std::span<const quint8> scores, int weight = 1);
+    Builder& wTally(const QStringList& candidates, qsizetype ballotCount, std::span<const Election::ScoreStatistics> statistics,
+                    std::span<const int> preferences);
+    Builder& wSummary(const ElectionSummary& partial);
+    void reset();
+    ElectionSummary build();
+};
+
+}
+
+#endif // ELECTIONSUMMARY_H
@@ -6,13 +6,14 @@
 
 // Project Includes
 #include "star/election.h"
+#include "star/electionsummary.h"
 #include "star/expectedelectionresult.h"
 #include "star/calculator.h"
 
 namespace Star
 {
 
-enum class ReferenceErrorType { NoError, CategoryConfig, BallotBox, ExpectedResult, CalcOptions };
+enum class ReferenceErrorType { NoError, CategoryConfig, BallotBox, ExpectedResult, CalcOptions, BinaryBallotBox, BinarySummary };
 
 struct ReferenceError
 {
@@ -28,6 +29,32 @@ STAR_BASE_EXPORT ReferenceError electionsFromReferenceInput(QList<Election>& ret
                                                             const QString& categoryConfigPath,
                                                             const QString& ballotBoxPath);
 
+STAR_BASE_EXPORT ReferenceError summariesFromReferenceInput(QList<ElectionSummary>& returnBuffer,
+                                                            const QString& categoryConfigPath,
+                                                            const QString& ballotBoxPath);
+
+STAR_BASE_EXPORT ReferenceError electionsFromPatternInput(QList<Election>& returnBuffer,
+                                                          const QString& categoryConfigPath,
+                                                          const QString& patternTallyPath);
+
+STAR_BASE_EXPORT ReferenceError summariesFromPatternInput(QList<ElectionSummary>& returnBuffer,
+                                                          const QString& categoryConfigPath,
+                                                          const QString& patternTallyPath);
+
+STAR_BASE_EXPORT ReferenceError electionsFromBinaryInput(QList<Election>& returnBuffer,
+                                                         const QString& binaryBallotBoxPath);
+
+STAR_BASE_EXPORT ReferenceError electionsToBinaryOutput(const QList<Election>& elections,
+                                                        const QString& binaryBallotBoxPath,
+                                                        bool checksum = true);
+
+STAR_BASE_EXPORT ReferenceError summariesFromBinaryInput(QList<ElectionSummary>& returnBuffer,
+                                                         const QString& binarySummaryPath);
+
+STAR_BASE_EXPORT ReferenceError summariesToBinaryOutput(const QList<ElectionSummary>& summaries,
+                                                        const QString& binarySummaryPath,
+                                                        bool checksum = true);
+
 STAR_BASE_EXPORT ReferenceError expectedResultsFromReferenceInput(QList<ExpectedElectionResult>& returnBuffer,
                                                                   const QString& resultSetPath);
 
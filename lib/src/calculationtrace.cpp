@@ -0,0 +1,460 @@
+// Unit Include
+#include "star/calculationtrace.h"
+
+// magic_enum Includes
+#include <magic_enum.hpp>
+
+// Project Includes
+#include "star/rank.h"
+
+namespace Star
+{
+
+namespace
+{
+    // Sequential reader for event data
+    class EventReader
+    {
+    private:
+        std::span<const qint32> mData;
+        const QStringList& mCandidates;
+        qsizetype mPos;
+
+    public:
+        EventReader(std::span<const qint32> data, const QStringList& candidates) :
+            mData(data),
+            mCandidates(candidates),
+            mPos(0)
+        {}
+
+        qint32 value() { return mData[mPos++]; }
+        QString candidate() { return mCandidates.value(value()); }
+        QString quotedCandidate()
+        {
+            QString c = candidate();
+            return c.isNull() ? QString() : '"' + c + '"';
+        }
+
+        QStringList candidateList()
+        {
+            qint32 count = value();
+            QStringList names;
+            names.reserve(count);
+            for(qint32 i = 0; i < count; i++)
+                names.append(candidate());
+            return names;
+        }
+
+        QString candidateGeneralSetString()
+        {
+            QStringList names = candidateList();
+            if(names.isEmpty())
+                return QString();
+
+            return "\t- " + names.join("\n\t- ");
+        }
+
+        QString rankListString(const QString& itemTemplate)
+        {
+            qint32 rankCount = value();
+            QString listStr;
+            for(qint32 i = 0; i < rankCount; i++)
+            {
+                qint32 rankValue = value();
+                QString candidateStr = itemTemplate.arg(i).arg(candidateList().join(R"(", ")")).arg(rankValue);
+                if(i != rankCount - 1)
+                    candidateStr += '\n';
+                listStr.append(candidateStr);
+            }
+
+            return listStr;
+        }
+    };
+}
+
+//===============================================================================================================
+// CalculationTrace
+//===============================================================================================================
+
+/*!
+ *  @class CalculationTrace star/calculationtrace.h
+ *
+ *  @brief The CalculationTrace class is a structured record of the steps taken by a Calculator while
+ *  determining the result of an election.
+ *
+ *  Each step is stored as an Event, which consists of a Kind and a small sequence of integers that hold
+ *  the relevant candidate IDs and numeric values. Candidate IDs are the same as those of the election that
+ *  was evaluated and can be resolved to names via candidates(). All events of a trace are packed into a single
+ *  buffer that is retained between calculations, so that capturing a trace is inexpensive.
+ *
+ *  The human readable form of any event, which is identical to what is emitted via Calculator::calculationDetail,
+ *  can be produced on demand with render().
+ *
+ *  @par Event Data
+ *  @parblock
+ *  The data of each event kind is laid out as follows, where a candidate is a candidate ID (or @c -1 for
+ *  none), a candidate list is a count followed by that many candidate IDs, and a ranking list is a count
+ *  of ranks, followed by the value, and then candidate list, of each rank:
+ *
+ *  @li @c InputCounts - Candidate count, ballot count, seat count
+ *  @li @c InitialScoreRankings, and all of the @c ...Rankings kinds - Ranking list
+ *  @li @c QualifierTop - Candidates needed, candidate list
+ *  @li @c AdvanceCandidates, @c CutCandidates, and @c BreakResult - Candidate list
+ *  @li @c QualifierResult - First seed, second seed, seeded simultaneously (0/1), complete (0/1), overflow
+ *  candidate list
+ *  @li @c DefactoWinnerCheck - First seed, candidate list
+ *  @li @c DefactoWinnerCheckWin, @c DefactoWinnerCheckFail, @c RunoffWinner, and @c DefactoWinnerSeatFill - Candidate
+ *  @li @c Runoff and @c RunoffCandidates - Candidate, candidate
+ *  @li @c RankByScore and all of the other @c RankBy... kinds - Rank::Order
+ *  @li @c BreakTieMostFiveStar, @c BreakTieHighestScore, and @c BreakTieRandom - Number of tied candidates
+ *  @li @c FillingSeat - Seat index
+ *  @li @c FinalResults - Winner candidate list, unresolved candidate list, unfilled seat count
+ *
+ *  All other kinds have no data.
+ *  @endparblock
+ *
+ *  @sa Calculator::setTraceEnabled() and Calculator::trace().
+ */
+
+//-Class Enums-----------------------------------------------------------------------------------------------
+//Public:
+/*!
+ *  @enum CalculationTrace::Kind
+ *
+ *  This enum represents the type of a calculation step. Each value corresponds to one of the details
+ *  that is emitted by Calculator::calculationDetail.
+ */
+
+//-Inner Structs----------------------------------------------------------------------------------------------
+//Public:
+/*!
+ *  @struct CalculationTrace::Event star/calculationtrace.h
+ *
+ *  @brief The CalculationTrace::Event struct is a view of a single step within a CalculationTrace.
+ *
+ *  An event is only valid for as long as the trace it came from is not modified or destroyed.
+ */
+
+/*!
+ *  @var CalculationTrace::Kind CalculationTrace::Event::kind
+ *
+ *  The type of step the event represents.
+ */
+
+/*!
+ *  @var std::span<const qint32> CalculationTrace::Event::data
+ *
+ *  The candidate IDs and values that pertain to the event.
+ */
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+//Public:
+/*!
+ *  Creates an empty calculation trace.
+ */
+CalculationTrace::CalculationTrace() {}
+
+//-Instance Functions-------------------------------------------------------------------------------------------------
+//Private:
+void CalculationTrace::reset(const QString& electionName, const QStringList& candidates)
+{
+    mElectionName = electionName;
+    mCandidates = candidates;
+
+    // Clearing retains capacity, so the buffers are only ever allocated once
+    mRecords.clear();
+    mData.clear();
+}
+
+void CalculationTrace::beginEvent(Kind kind)
+{
+    // Reserve on the first event, so that calculations which never trace don't allocate anything
+    if(mRecords.capacity() == 0)
+    {
+        mRecords.reserve(RESERVED_EVENTS);
+        mData.reserve(RESERVED_DATA);
+    }
+
+    mRecords.append(Record{.kind = kind, .offset = mData.size(), .length = 0});
+}
+
+void CalculationTrace::appendValue(qint32 value) { mData.append(value); }
+void CalculationTrace::endEvent()
+{
+    Record& r = mRecords.last();
+    r.length = mData.size() - r.offset;
+}
+
+//Public:
+/*!
+ *  Returns @c true if the trace contains no events; otherwise, returns @c false.
+ */
+bool CalculationTrace::isEmpty() const { return mRecords.isEmpty(); }
+
+/*!
+ *  Returns the number of events in the trace.
+ */
+qsizetype CalculationTrace::count() const { return mRecords.size(); }
+
+/*!
+ *  Returns the name of the election the trace pertains to.
+ */
+QString CalculationTrace::electionName() const { return mElectionName; }
+
+/*!
+ *  Returns the candidates of the election the trace pertains to, such that the position of each candidate
+ *  is equal to their ID.
+ */
+QStringList CalculationTrace::candidates() const { return mCandidates; }
+
+/*!
+ *  Returns the event at index @a i.
+ */
+CalculationTrace::Event CalculationTrace::event(qsizetype i) const
+{
+    Q_ASSERT_X(size_t(i) < size_t(mRecords.size()), "CalculationTrace::event", "index out of range");
+
+    const Record& r = mRecords.at(i);
+    return Event{.kind = r.kind, .data = std::span<const qint32>(mData.constData() + r.offset, r.length)};
+}
+
+/*!
+ *  Returns the indices of all events of kind @a kind, in order.
+ */
+QList<qsizetype> CalculationTrace::find(Kind kind) const
+{
+    QList<qsizetype> indices;
+    for(qsizetype i = 0; i < mRecords.size(); i++)
+        if(mRecords.at(i).kind == kind)
+            indices.append(i);
+
+    return indices;
+}
+
+/*!
+ *  Returns the human readable form of the event at index @a i.
+ */
+QString CalculationTrace::render(qsizetype i) const
+{
+    Event e = event(i);
+    EventReader reader(e.data, mCandidates);
+
+    auto orderName = [&reader]{
+        return QString(magic_enum::enum_name(static_cast<Rank::Order>(reader.value())).data());
+    };
+
+    switch(e.kind)
+    {
+        case InvalidElection:
+            return TEXT_INVALID_ELECTION;
+
+        case CalculationStart:
+            return TEXT_CALC_START.arg(mElectionName) + '\n' + QString(120,'#');
+
+        case InputCounts:
+        {
+            qint32 candidates = reader.value();
+            qint32 ballots = reader.value();
+            qint32 seats = reader.value();
+            return TEXT_INPUT_COUNTS.arg(candidates).arg(ballots).arg(seats);
+        }
+
+        case InitialScoreRankings:
+            return TEXT_INITAL_RAW_RANKINGS + '\n' + reader.rankListString(LIST_ITEM_RANK);
+
+        case HeadToHeadPrecalculation:
+            return TEXT_CALC_HEAD_TO_HEAD;
+
+        case Qualifier:
+            return TEXT_QUALIFIER;
+
+        case QualifierTop:
+        {
+            qint32 needed = reader.value();
+            return TEXT_QUALIFIER_TOP.arg(needed) + '\n' + reader.candidateGeneralSetString();
+        }
+
+        case AdvanceCandidates:
+            return TEXT_QUALIFIER_ADVANCE_CANDIDATES + '\n' + reader.candidateGeneralSetString();
+
+        case CutCandidates:
+            return TEXT_QUALIFIER_CUT_CANDIDATES + '\n' + reader.candidateGeneralSetString();
+
+        case QualifierNoRandom:
+            return TEXT_QUALIFIER_NO_RANDOM;
+
+        case QualifierUnsuccessful:
+            return TEXT_QUALIFIER_UNSUCCESSFUL;
+
+        case QualifierResult:
+        {
+            QString strFs = reader.quotedCandidate();
+            QString strSs = reader.quotedCandidate();
+            bool simultaneous = reader.value();
+            bool complete = reader.value();
+            QStringList overflow = reader.candidateList();
+            QString strOf = complete ? "" : '"' + overflow.join(R"(", ")") + '"';
+
+            return TEXT_QUALIFIER_RESULT.arg(strFs, strSs, simultaneous ? "true" : "false", strOf);
+        }
+
+        case DefactoWinnerCheck:
+        {
+            QString firstSeed = reader.candidate();
+            return TEXT_DEFACTO_WINNER_CHECK.arg(firstSeed) + '\n' + reader.candidateGeneralSetString();
+        }
+
+        case DefactoWinnerCheckWin:
+            return TEXT_DEFACTO_WINNER_CHECK_WIN.arg(reader.candidate());
+
+        case DefactoWinnerCheckFail:
+            return TEXT_DEFACTO_WINNER_CHECK_FAIL.arg(reader.candidate());
+
+        case DefactoWinnerCheckSuccess:
+            return TEXT_DEFACTO_WINNER_CHECK_SUCCESS;
+
+        case Runoff:
+        {
+            QString a = reader.candidate();
+            QString b = reader.candidate();
+            return TEXT_RUNOFF.arg(a, b);
+        }
+
+        case RunoffHeadToHeadWinnerCheck:
+            return TEXT_RUNOFF_HEAD_TO_HEAD_WINNER_CHECK;
+
+        case RunoffTie:
+            return TEXT_RUNOFF_TIE;
+
+        case RunoffHigherScoreCheck:
+            return TEXT_RUNOFF_HIGHER_SCORE_CHECK;
+
+        case RunoffMoreFiveStarCheck:
+            return TEXT_RUNOFF_MORE_FIVE_STAR_CHECK;
+
+        case RunoffChoosingRandomWinner:
+            return TEXT_RUNOFF_CHOOSING_RANDOM_WINNER;
+
+        case RunoffNoRandom:
+            return TEXT_RUNOFF_NO_RANDOM;
+
+        case RunoffWinner:
+            return TEXT_RUNOFF_WINNER.arg(reader.candidate());
+
+        case RunoffUnresolved:
+            return TEXT_RUNOFF_UNRESOLVED;
+
+        case RankByScore:
+            return TEXT_RANK_BY_SCORE.arg(orderName());
+
+        case ScoreRankings:
+            return TEXT_RANKINGS_SCORE + '\n' + reader.rankListString(LIST_ITEM_RANK);
+
+        case RankByVotesOfMaxScore:
+            return TEXT_RANK_BY_VOTES_OF_MAX_SCORE.arg(orderName());
+
+        case VotesOfMaxScoreRankings:
+            return TEXT_RANKINGS_VOTES_OF_MAX_SCORE + '\n' + reader.rankListString(LIST_ITEM_RANK);
+
+        case RankByHeadToHeadLosses:
+            return TEXT_RANK_BY_HEAD_TO_HEAD_LOSSES.arg(orderName());
+
+        case HeadToHeadLossesRankings:
+            return TEXT_RANKINGS_HEAD_TO_HEAD_LOSSES + '\n' + reader.rankListString(LIST_ITEM_RANK);
+
+        case RankByHeadToHeadPreferences:
+            return TEXT_RANK_BY_HEAD_TO_HEAD_PREFERENCES.arg(orderName());
+
+        case HeadToHeadPreferencesRankings:
+            return TEXT_RANKINGS_HEAD_TO_HEAD_PREFERENCES + '\n' + reader.rankListString(LIST_ITEM_RANK);
+
+        case RankByHeadToHeadMargin:
+            return TEXT_RANK_BY_HEAD_TO_HEAD_MARGIN.arg(orderName());
+
+        case HeadToHeadMarginRankings:
+            return TEXT_RANKINGS_HEAD_TO_HEAD_MARGIN + '\n' + reader.rankListString(LIST_ITEM_RANK);
+
+        case BreakTieMostFiveStar:
+            return TEXT_BREAK_TIE_MOST_FIVE_STAR.arg(reader.value());
+
+        case BreakTieHighestScore:
+            return TEXT_BREAK_TIE_HIGHEST_SCORE.arg(reader.value());
+
+        case BreakTieRandom:
+            return TEXT_BREAK_TIE_RANDOM.arg(reader.value());
+
+        case BreakResult:
+            return TEXT_BREAK_RESULT.arg(reader.candidateList().join(", "));
+
+        case FillingSeat:
+            return TEXT_FILLING_SEAT.arg(reader.value());
+
+        case DirectSeatFill:
+            return TEXT_DIRECT_SEAT_FILL;
+
+        case RunoffCandidates:
+        {
+            QString first = reader.candidate();
+            QString second = reader.candidate();
+            return TEXT_RUNOFF_CANDIDATES.arg(first, second);
+        }
+
+        case NoRunoff:
+            return TEXT_NO_RUNOFF;
+
+        case DefactoWinnerSeatFill:
+            return TEXT_DEFACTO_WINNER_SEAT_FILL.arg(reader.candidate());
+
+        case PrimaryRunoff:
+            return TEXT_PERFORM_PRIMARY_RUNOFF;
+
+        case FinalResults:
+        {
+            // Create filled seats string
+            QString seatListStr;
+            const QStringList winners = reader.candidateList();
+
+            if(winners.isEmpty())
+                seatListStr = LIST_ITEM_NONE + '\n';
+            else
+                for(qsizetype s = 0; s < winners.size(); s++)
+                    seatListStr.append(LIST_ITEM_SEAT.arg(s).arg(winners.at(s)) + '\n');
+
+            // Create unresolved candidates string
+            QString unresolvedListStr;
+            const QStringList unresolved = reader.candidateList();
+
+            if(unresolved.isEmpty())
+                unresolvedListStr = LIST_ITEM_NONE + '\n';
+            else
+                for(const QString& candidate : unresolved)
+                    unresolvedListStr.append(LIST_ITEM_UNRESOLVED.arg(candidate) + '\n');
+
+            qint32 unfilled = reader.value();
+            return TEXT_FINAL_RESULTS.arg(seatListStr, unresolvedListStr).arg(unfilled);
+        }
+
+        case CalculationFinish:
+            return TEXT_CALC_FINISH + '\n' + QString(120,'-');
+    }
+
+    Q_UNREACHABLE();
+    return QString();
+}
+
+/*!
+ *  @overload
+ *
+ *  Returns the human readable form of every event in the trace, in order.
+ */
+QStringList CalculationTrace::render() const
+{
+    QStringList text;
+    text.reserve(count());
+    for(qsizetype i = 0; i < count(); i++)
+        text.append(render(i));
+
+    return text;
+}
+
+}
@@ -1,21 +1,28 @@
 // Unit Include
 #include "star/calculator.h"
 
+// Standard Library Includes
+#include <algorithm>
+#include <memory>
+
 // Qt Includes
 #include <QRandomGenerator>
+#include <QThread>
+#include <QThreadPool>
+#include <QMetaMethod>
 
 // Qx Includes
-#include <qx/core/qx-string.h>
 #include <qx/core/qx-algorithm.h>
 
-// magic_enum Includes
-#include <magic_enum.hpp>
-
 // Project Includes
-#include "headtoheadresults.h"
+#include "calculatorcontext.h"
+#include "ranksorter.h"
 
 //-Macros----------------------------------------
-#define ENUM_NAME(eenum) QString(magic_enum::enum_name(eenum).data())
+/* Only records the event (and therefore evaluates its payload) if the trace is wanted or something is
+ * listening for details, so that calculations performed without any interest in either don't pay for them
+ */
+#define TRACE(...) do{ if(mTracing) traceEvent(__VA_ARGS__); }while(false)
 
 namespace Star
 {
@@ -34,12 +41,24 @@ namespace Star
  *  Calculator(const Election*), followed by calling calculateResult().
  *
  *  If running multiple elections, there is no need to create a Calculator for each one, as a single Calculator
- *  can be reused for subsequent elections by using setElection().
+ *  can be reused for subsequent elections by using setElection(). Alternatively, several independent elections
+ *  can be evaluated concurrently with calculateResults().
+ *
+ *  An election whose ballots are too numerous to keep can instead be reduced to an ElectionSummary as its
+ *  ballots are read, which can then be evaluated via calculateResult(const ElectionSummary&).
+ *
+ *  Since calculateResult() records the trace of each calculation within the calculator, it can only be used
+ *  by one thread at a time. evaluate() is the reentrant counterpart, which keeps all intermediate state of a
+ *  calculation to itself and never modifies the calculator, so that one configured calculator can serve any
+ *  number of threads at once instead of each needing its own.
  *
- *  @note An ElectionResult created by calculateResult() requires referring to the Election it originated from
- *  in order to return the correct values from some of its methods; therefore, generally one should guarantee
- *  that Elections provided to a Calculator will not be deleted as long as their corresponding results are in
- *  use.
+ *  Elections that take long enough to evaluate that waiting on them is undesirable, such as those for many
+ *  seats, can instead be evaluated in the background with evaluateAsync(), which reports progress and can be
+ *  canceled through the returned QFuture.
+ *
+ *  @note An ElectionResult keeps the summary of the election it was determined from, so it remains usable
+ *  after that Election is deleted, with the exception of ElectionResult::election() which refers to the
+ *  Election directly.
  *
  *  @par Options
  *  @parblock
@@ -138,17 +157,350 @@ namespace Star
  */
 Calculator::Calculator(const Election* election) :
     mElection(election),
-    mOptions(Option::NoOptions)
+    mOptions(Option::NoOptions),
+    mThreadCount(1),
+    mThreadCountSet(false),
+    mTraceEnabled(false)
 {}
 
+//-Instance Functions-------------------------------------------------------------------------------------------------
+//Private:
+bool Calculator::hasDetailReceivers() const { return isSignalConnected(QMetaMethod::fromSignal(&Calculator::calculationDetail)); }
+
+ElectionResult Calculator::calculate(const ElectionSummary& summary, const Election* ballots, int threadCount, CalculationTrace* trace,
+                                     bool record, bool emitDetails) const
+{
+    // Everything specific to this calculation is kept in its own context, so the calculator itself is never modified
+    Context context(this, summary, ballots, threadCount, record, emitDetails);
+    ElectionResult result = context.calculate();
+
+    if(trace)
+        *trace = context.takeTrace();
+
+    return result;
+}
+
+QFuture<ElectionResult> Calculator::calculateAsync(const ElectionSummary& summary, const Election* ballots, QThreadPool* pool) const
+{
+    // Shared since the pool only accepts copyable tasks
+    auto promise = std::make_shared<QPromise<ElectionResult>>();
+    QFuture<ElectionResult> future = promise->future();
+    promise->start();
+
+    // Whether details are wanted is decided now, rather than whenever the calculation happens to begin
+    bool emitDetails = hasDetailReceivers();
+    int threadCount = mThreadCount;
+
+    (pool ? pool : QThreadPool::globalInstance())->start([=, this]{
+        // Skip the calculation entirely if it was canceled while still queued
+        if(!promise->isCanceled())
+        {
+            Context context(this, summary, ballots, threadCount, false, emitDetails, promise.get());
+            ElectionResult result = context.calculate();
+            if(!promise->isCanceled())
+                promise->addResult(result);
+        }
+
+        promise->finish();
+    });
+
+    return future;
+}
+
+//Public:
+/*!
+ *  Returns the current election that the calculator is set to evaluate, or @c nullptr if none is set.
+ *
+ *  @sa Calculator(), and setElection().
+ */
+const Election* Calculator::election() const { return mElection; }
+
+/*!
+ *  Returns the current option set of the calculator.
+ *
+ *  @sa setOptions().
+ */
+Calculator::Options Calculator::options() const { return mOptions; }
+
 /*!
- * Destroys the calculator
+ *  Returns the number of threads the calculator is allowed to use.
+ *
+ *  The default is @c 1, though calculateResults() uses QThread::idealThreadCount() threads instead as long
+ *  as setThreadCount() was never called.
+ *
+ *  @sa setThreadCount().
+ */
+int Calculator::threadCount() const { return mThreadCount; }
+
+/*!
+ *  Returns @c true if the calculator keeps a trace of each calculation; otherwise, returns @c false.
+ *
+ *  The default is @c false.
+ *
+ *  @sa setTraceEnabled() and trace().
+ */
+bool Calculator::isTraceEnabled() const { return mTraceEnabled; }
+
+/*!
+ *  Returns the trace of the most recent call to calculateResult().
+ *
+ *  The trace is only populated if tracing was enabled, or calculationDetail was connected, when that
+ *  calculation was started; otherwise, it is empty. It is replaced at the start of each calculation.
+ *
+ *  @sa setTraceEnabled().
+ */
+const CalculationTrace& Calculator::trace() const { return mTrace; }
+
+/*!
+ *  Sets the calculator to evaluate the Election @a election.
+ *
+ *  @sa election().
  */
-Calculator::~Calculator() = default;
+void Calculator::setElection(const Election* election) { mElection = election; }
+
+/*!
+ *  Sets the calculator options set to @a options.
+ *
+ *  @sa options().
+ */
+void Calculator::setOptions(Options options) { mOptions = options; }
+
+/*!
+ *  Sets the number of threads the calculator is allowed to use to @a count.
+ *
+ *  With calculateResult(), the threads are used to tally head-to-head matchups, which happens the first time
+ *  each matchup is needed. Head-to-head results are the sum of every ballot's preferences, so the ballots of an
+ *  election are split into shards that are evaluated concurrently before being combined. This is only worthwhile
+ *  for elections with a large number of ballots, as each thread is given whole blocks of several thousand
+ *  ballots at a time.
+ *
+ *  With calculateResults(), the threads are instead used to evaluate separate elections at the same time.
+ *
+ *  If @a count is less than @c 1, QThread::idealThreadCount() is used instead.
+ *
+ *  @sa threadCount().
+ */
+void Calculator::setThreadCount(int count)
+{
+    mThreadCount = count < 1 ? QThread::idealThreadCount() : count;
+    mThreadCountSet = true;
+}
+
+/*!
+ *  Enables or disables the recording of a CalculationTrace during each calculation according to @a enabled.
+ *
+ *  Unlike calculationDetail, a trace is kept as compact typed data and is only turned into text if
+ *  it is rendered, which makes it the cheaper of the two options for inspecting how a result was reached.
+ *
+ *  @sa isTraceEnabled() and trace().
+ */
+void Calculator::setTraceEnabled(bool enabled) { mTraceEnabled = enabled; }
+
+/*!
+ *  Determines the outcome of the currently set election in accordance with the current options set
+ *  and returns it as an ElectionResult.
+ *
+ *  If no election is set or the current one is invalid, a null ElectionResult is returned.
+ *
+ *  If the election has a live tally, its head-to-head preferences are used as they are instead of being
+ *  determined from its ballots, so the cost of the calculation no longer depends on the number of ballots.
+ *  Otherwise, each ballot is examined once regardless of its weight, so building the election with
+ *  Election::Builder::wCollapseDuplicates() reduces the cost to that of its distinct ballots.
+ *
+ *  @sa isNull(), calculationDetail, and Election::enableLiveTally().
+ */
+ElectionResult Calculator::calculateResult()
+{
+    ElectionSummary summary = mElection ? mElection->summary() : ElectionSummary();
+    return calculate(summary, mElection, mThreadCount, &mTrace, mTraceEnabled, hasDetailReceivers());
+}
+
+/*!
+ *  Determines the outcome of the election described by @a summary in accordance with the current options set
+ *  and returns it as an ElectionResult.
+ *
+ *  This allows an election to be evaluated without any of its ballots, for instance one whose ballots were
+ *  streamed into an ElectionSummary::Builder. The currently set election is ignored and left unchanged, and
+ *  the resulting ElectionResult has no election, only a summary.
+ *
+ *  If the summary is invalid or does not include head-to-head preferences, a null ElectionResult is returned.
+ *
+ *  @sa calculateResult(), ElectionSummary::hasPreferences(), and ElectionResult::summary().
+ */
+ElectionResult Calculator::calculateResult(const ElectionSummary& summary)
+{
+    return calculate(summary, nullptr, mThreadCount, &mTrace, mTraceEnabled, hasDetailReceivers());
+}
+
+/*!
+ *  Determines the outcome of @a election in accordance with the current options set and returns it as an
+ *  ElectionResult, exactly as calculateResult() would if @a election were the currently set election.
+ *
+ *  Unlike calculateResult(), this leaves the calculator completely untouched, as everything needed while
+ *  the election is being evaluated is kept separately for each call. Any number of calls can therefore be
+ *  made at the same time from different threads, so a single calculator can be configured once and then
+ *  shared by every thread that needs to evaluate elections, as long as its settings are not changed while
+ *  it is in use.
+ *
+ *  If @a trace is not @c nullptr, it is replaced with the trace of the calculation, regardless of
+ *  isTraceEnabled(). trace() is not affected.
+ *
+ *  Details are still emitted via calculationDetail if it is connected, from the thread that made the call,
+ *  so receivers of concurrent calculations must be able to handle details from several threads at once,
+ *  which are interleaved.
+ *
+ *  @sa calculateResult() and setThreadCount().
+ */
+ElectionResult Calculator::evaluate(const Election* election, CalculationTrace* trace) const
+{
+    ElectionSummary summary = election ? election->summary() : ElectionSummary();
+    return calculate(summary, election, mThreadCount, trace, trace != nullptr, hasDetailReceivers());
+}
+
+/*!
+ *  @overload
+ *
+ *  Determines the outcome of the election described by @a summary, exactly as calculateResult(const ElectionSummary&)
+ *  would, but without modifying the calculator.
+ */
+ElectionResult Calculator::evaluate(const ElectionSummary& summary, CalculationTrace* trace) const
+{
+    return calculate(summary, nullptr, mThreadCount, trace, trace != nullptr, hasDetailReceivers());
+}
+
+/*!
+ *  Starts determining the outcome of @a election in accordance with the current options set on @a pool, or
+ *  the global thread pool if @a pool is @c nullptr, and returns a future for the resulting ElectionResult.
+ *
+ *  The calculation is performed exactly as it would be by evaluate(), so the calculator is not modified and
+ *  any number of calculations can be in progress at once. Both the calculator and @a election must outlive
+ *  the calculation, and neither may be changed until it finishes.
+ *
+ *  The future's progress advances once for each head-to-head matchup tallied and once for each seat filled,
+ *  along with a description of both counts. Since matchups are only tallied once they're needed, the progress
+ *  jumps to its maximum once the last seat is filled, as any remaining matchups are never tallied at all.
+ *
+ *  Canceling the future stops the calculation cooperatively, at the next seat or the next matchup tallied,
+ *  whichever comes first, and leaves it without a result.
+ *
+ *  Details are emitted via calculationDetail from the thread performing the calculation if it was connected
+ *  when this function was called.
+ *
+ *  @sa evaluate() and QFuture::cancel().
+ */
+QFuture<ElectionResult> Calculator::evaluateAsync(const Election* election, QThreadPool* pool) const
+{
+    ElectionSummary summary = election ? election->summary() : ElectionSummary();
+    return calculateAsync(summary, election, pool);
+}
+
+/*!
+ *  @overload
+ *
+ *  Starts determining the outcome of the election described by @a summary, which is copied, exactly as
+ *  evaluate(const ElectionSummary&) would.
+ */
+QFuture<ElectionResult> Calculator::evaluateAsync(const ElectionSummary& summary, QThreadPool* pool) const
+{
+    return calculateAsync(summary, nullptr, pool);
+}
+
+/*!
+ *  Determines the outcome of each election in @a elections in accordance with the current options set
+ *  and returns them as a list of ElectionResult, in the same order as @a elections.
+ *
+ *  The elections are evaluated concurrently using up to threadCount() threads, or QThread::idealThreadCount()
+ *  threads if setThreadCount() was never called, with each one being handled exactly as it would be by
+ *  calculateResult(). The currently set election is ignored and left unchanged.
+ *
+ *  Calculation details for each election are collected as it is evaluated and then emitted via calculationDetail
+ *  once all elections are finished, one election at a time and in the same order as @a elections, so that they
+ *  are identical to those that would be produced by evaluating each election in turn.
+ *
+ *  @sa calculateResult().
+ */
+QList<ElectionResult> Calculator::calculateResults(const QList<const Election*>& elections)
+{
+    QList<ElectionResult> results(elections.size());
+    QList<QStringList> details(elections.size());
+    ElectionResult* resultData = results.data();
+    QStringList* detailData = details.data();
+    bool collectDetails = hasDetailReceivers();
+
+    /* Evaluate each election in its own context, each tallying with a single thread since the threads are
+     * already spent on separate elections. Unlike a single calculation, a batch is always worth spreading
+     * out, so it isn't limited to the default of one thread.
+     */
+    QThreadPool pool;
+    pool.setMaxThreadCount(mThreadCountSet ? mThreadCount : QThread::idealThreadCount());
+
+    for(qsizetype i = 0; i < elections.size(); i++)
+    {
+        const Election* election = elections.at(i);
+
+        pool.start([=, this]{
+            CalculationTrace trace;
+            ElectionSummary summary = election ? election->summary() : ElectionSummary();
+            resultData[i] = calculate(summary, election, 1, &trace, collectDetails, false);
+
+            // Details are only rendered from the trace once the result is known
+            if(collectDetails)
+                detailData[i] = trace.render();
+        });
+    }
+
+    pool.waitForDone();
+
+    // Replay details in election order
+    for(const QStringList& electionDetails : std::as_const(details))
+        for(const QString& detail : electionDetails)
+            emit calculationDetail(detail);
+
+    return results;
+}
+
+/*!
+ *  @fn void Calculator::calculationDetail(const QString& detail)
+ *
+ *  This signal is emitted at various points during the execution of calculateResult() and calculateResults().
+ *
+ *  It provides numerous details about the entire calculation process that are useful for logging and
+ *  gaining insight into the STAR election procedure.
+ *
+ *  Producing these details has a cost, so they are only generated if this signal is connected to at least
+ *  one receiver at the time a calculation is started. Each detail is the rendered form of an event from the
+ *  calculation's trace, which can instead be kept and inspected in its typed form with setTraceEnabled().
+ *
+ *  @sa calculateResult() and trace().
+ */
+
+//===============================================================================================================
+// Calculator::Context
+//===============================================================================================================
+
+/*! @cond */
+//-Constructor---------------------------------------------------------------------------------------------------------
+//Public:
+Calculator::Context::Context(const Calculator* calculator, const ElectionSummary& summary, const Election* ballots, int threadCount,
+                             bool record, bool emitDetails, QPromise<ElectionResult>* promise) :
+    mCalculator(calculator),
+    mOptions(calculator->options()),
+    mThreadCount(threadCount),
+    mSummary(summary),
+    mBallots(ballots),
+    mDetailsEnabled(emitDetails),
+    mTracing(record || emitDetails), // Details are rendered from the trace, so it's needed for either
+    mPromise(promise),
+    mPairCount(0),
+    mPairsTallied(0),
+    mSeatsFilled(0)
+{
+    mTrace.reset(mSummary.name(), mSummary.candidates());
+}
 
 //-Instance Functions-------------------------------------------------------------------------------------------------
 //Private:
-QualifierResult Calculator::performRunoffQualifier(const QList<Rank>& scoreRankings) const
+std::pair<CandidateSet, CandidateSet> Calculator::Context::performRunoffQualifier(const QList<CandidateRank>& scoreRankings) const
 {
     /* Overall this function attempts to break the tied candidates by selecting the winner(s) of the tie in
      * a similar fashion to Bloc voting. One candidate is selected as the winner and then if a second
@@ -157,28 +509,31 @@ QualifierResult Calculator::performRunoffQualifier(const QList<Rank>& scoreRanki
      * one candidate can be set aside.
      */
 
-    emit calculationDetail(LOG_EVENT_QUALIFIER);
+    TRACE(CalculationTrace::Qualifier);
 
     // Only the first two score ranks are ever relevant
-    QList<Rank> contenderRankings = scoreRankings.first(std::min(scoreRankings.size(), qsizetype(2)));
+    int candidateCount = int(mSummary.candidateCount());
+    QVarLengthArray<CandidateSet, 2> contenders;
+    for(qsizetype r = 0; r < std::min(scoreRankings.size(), qsizetype(2)); r++)
+        contenders.append(scoreRankings.at(r).candidates);
 
     // Results to fill
-    QSet<QString> firstAdvancement;
-    QSet<QString> secondAdvancement;
+    CandidateSet firstAdvancement(candidateCount);
+    CandidateSet secondAdvancement(candidateCount);
 
     // Need tracker
     qsizetype candidatesNeeded = 2;
 
     // Convenience functions for manipulating candidates
-    const auto removeContenders = [&](const QSet<QString>& c){
-        Rank& topRank = contenderRankings.first();
-        topRank.candidates.subtract(c);
-        if(topRank.candidates.isEmpty())
-            contenderRankings.removeFirst();
+    const auto removeContenders = [&](const CandidateSet& c){
+        CandidateSet& topRank = contenders.first();
+        topRank.subtract(c);
+        if(topRank.isEmpty())
+            contenders.remove(0);
     };
 
-    const auto advanceCandidates = [&](const QSet<QString>& c){
-        emit calculationDetail(LOG_EVENT_QUALIFIER_ADVANCE_CANDIDATES + '\n' + createCandidateGeneralSetString(c));
+    const auto advanceCandidates = [&](const CandidateSet& c){
+        TRACE(CalculationTrace::AdvanceCandidates, c);
 
         if(firstAdvancement.isEmpty())
             firstAdvancement = c;
@@ -188,33 +543,37 @@ QualifierResult Calculator::performRunoffQualifier(const QList<Rank>& scoreRanki
             qFatal("attempted to advance candidates more than twice!");
 
         removeContenders(c);
-        candidatesNeeded -= c.size();
+        candidatesNeeded -= c.count();
     };
 
     // Seed candidates until at 2
     while(candidatesNeeded > 0)
     {
         // Get candidates from top score rank
-        QSet<QString> topCandidates = contenderRankings.front().candidates;
-        emit calculationDetail(LOG_EVENT_QUALIFIER_TOP.arg(candidatesNeeded) + '\n' + createCandidateGeneralSetString(topCandidates));
+        const CandidateSet topCandidates = contenders.front();
+        TRACE(CalculationTrace::QualifierTop, candidatesNeeded, topCandidates);
 
         // Advance candidates directly if possible
-        if(topCandidates.size() <= candidatesNeeded)
+        if(topCandidates.count() <= candidatesNeeded)
         {
             advanceCandidates(topCandidates);
             continue;
         }
 
-        // Get head-to-head results of score tied candidates
-        HeadToHeadResults tiedHtH = mHeadToHeadResults->narrowed(topCandidates, HeadToHeadResults::Inclusive);
+        /* Narrow head-to-head consideration to the score tied candidates
+         *
+         * The full head-to-head results are only ever queried with respect to this set, so culling
+         * candidates is simply a matter of clearing their bits.
+         */
+        CandidateSet tied = topCandidates;
 
         // Convenience functions for candidate culling and advancement
-        const auto tryCullLosers = [&](const QList<Rank>& loserFirstRankings){
+        const auto tryCullLosers = [&](const QList<CandidateRank>& loserFirstRankings){
             if(loserFirstRankings.size() > 1)
             {
-                const QSet<QString>& toCut = loserFirstRankings.front().candidates;
-                emit calculationDetail(LOG_EVENT_QUALIFIER_CUT_CANDIDATES + '\n' + createCandidateGeneralSetString(toCut));
-                tiedHtH.narrow(toCut, HeadToHeadResults::Exclusive);
+                const CandidateSet& toCut = loserFirstRankings.front().candidates;
+                TRACE(CalculationTrace::CutCandidates, toCut);
+                tied.subtract(toCut);
                 return true;
             }
             else
@@ -222,9 +581,9 @@ QualifierResult Calculator::performRunoffQualifier(const QList<Rank>& scoreRanki
         };
 
         const auto tryAdvanceRemaining = [&]{
-            if(tiedHtH.candidateCount() <= candidatesNeeded)
+            if(tied.count() <= candidatesNeeded)
             {
-                advanceCandidates(tiedHtH.candidates());
+                advanceCandidates(tied);
                 return true;
             }
             else
@@ -235,9 +594,9 @@ QualifierResult Calculator::performRunoffQualifier(const QList<Rank>& scoreRanki
         forever
         {
             // Sort remaining by head-to-head losses
-            const QList<Rank> lossRankings = rankByHeadToHeadLosses(tiedHtH.candidates(), &tiedHtH, Rank::Descending);
+            const QList<CandidateRank> lossRankings = rankByHeadToHeadLosses(tied, Rank::Descending, rankDepth(2));
 
-            // If possible, remove the candidates with the most losses, adjust the head-to-head results, then repeat
+            // If possible, remove the candidates with the most losses, then repeat
             if(tryCullLosers(lossRankings))
                 continue;
 
@@ -246,7 +605,7 @@ QualifierResult Calculator::performRunoffQualifier(const QList<Rank>& scoreRanki
                 break;
 
             // Sort remaining by 5-star votes
-            const QList<Rank> fiveStarRankings = rankByVotesOfMaxScore(tiedHtH.candidates(), Rank::Ascending);
+            const QList<CandidateRank> fiveStarRankings = rankByVotesOfMaxScore(tied, Rank::Ascending, RankSorter::ALL_RANKS);
 
             /* If possible, advance the clear 5-star winner(s), then restart the whole process
              *
@@ -263,7 +622,7 @@ QualifierResult Calculator::performRunoffQualifier(const QList<Rank>& scoreRanki
              * Here if two candidates are still needed, Mandy and Kyle would be set aside for advancement at the same time instead of
              * just taking Mandy and then restarting.
              */
-            QSet<QString> fiveStarAdv;
+            CandidateSet fiveStarAdv(candidateCount);
 
             /* TODO: for(const Rank& r : fiveStarRankings | std::views::reverse)
              *
@@ -273,12 +632,12 @@ QualifierResult Calculator::performRunoffQualifier(const QList<Rank>& scoreRanki
              */
             for(auto rItr = fiveStarRankings.crbegin(); rItr != fiveStarRankings.crend(); rItr++)
             {
-                qsizetype room = candidatesNeeded - fiveStarAdv.size();
+                qsizetype room = candidatesNeeded - fiveStarAdv.count();
 
                 if(room == 0)
                     break;
 
-                if(rItr->candidates.size() <= room)
+                if(rItr->candidates.count() <= room)
                     fiveStarAdv.unite(rItr->candidates);
                 else
                     break;
@@ -302,9 +661,9 @@ QualifierResult Calculator::performRunoffQualifier(const QList<Rank>& scoreRanki
                  */
 
                 // Sort remaining by head-to-head preferences
-                const QList<Rank> prefRankings = rankByHeadToHeadPreferences(tiedHtH.candidates(), &tiedHtH, Rank::Ascending);
+                const QList<CandidateRank> prefRankings = rankByHeadToHeadPreferences(tied, Rank::Ascending, rankDepth(2));
 
-                // If possible, remove the candidates with the least preferences, adjust the head-to-head results, then repeat this sub process
+                // If possible, remove the candidates with the least preferences, then repeat this sub process
                 if(tryCullLosers(prefRankings))
                     continue;
 
@@ -313,9 +672,9 @@ QualifierResult Calculator::performRunoffQualifier(const QList<Rank>& scoreRanki
                     break;
 
                 // Sort remaining by head-to-head margin
-                const QList<Rank> marginRankings = rankByHeadToHeadMargin(tiedHtH.candidates(), &tiedHtH, Rank::Ascending);
+                const QList<CandidateRank> marginRankings = rankByHeadToHeadMargin(tied, Rank::Ascending, rankDepth(2));
 
-                // If possible, remove the candidates with the lowest margin, adjust the head-to-head results, then repeat this sub process
+                // If possible, remove the candidates with the lowest margin, then repeat this sub process
                 if(tryCullLosers(marginRankings))
                     continue;
 
@@ -326,445 +685,458 @@ QualifierResult Calculator::performRunoffQualifier(const QList<Rank>& scoreRanki
 
             // If true ties are not allowed, use a random tiebreak to select one to advance; otherwise, simply "advance" the remaining candidates
             if(!mOptions.testFlag(Option::AllowTrueTies))
-                advanceCandidates({breakTieRandom(tiedHtH.candidates())});
+            {
+                CandidateSet chosen(candidateCount);
+                chosen.insert(breakTieRandom(tied));
+                advanceCandidates(chosen);
+            }
             else
             {
-                emit calculationDetail(LOG_EVENT_QUALIFIER_NO_RANDOM);
-                advanceCandidates(tiedHtH.candidates());
+                TRACE(CalculationTrace::QualifierNoRandom);
+                advanceCandidates(tied);
             }
 
             break;
         }
     }
 
-    // Create qualifier result
-    QualifierResult res(firstAdvancement, secondAdvancement);
+    // Return the advanced candidates, ideally two in total
+    return std::make_pair(firstAdvancement, secondAdvancement);
+}
+
+QualifierResult Calculator::Context::qualifierResult(const CandidateSet& firstAdvancement, const CandidateSet& secondAdvancement) const
+{
+    // Both seeds filled at once are given in ID order, which the runoff also uses
+    QualifierResult res;
+    if(firstAdvancement.count() == 2)
+    {
+        auto fItr = firstAdvancement.begin();
+        int firstSeed = *fItr;
+        int secondSeed = *(++fItr);
+        res = QualifierResult(mSummary.candidateName(firstSeed), mSummary.candidateName(secondSeed), true, {});
+    }
+    else
+        res = QualifierResult(candidateNames(firstAdvancement), candidateNames(secondAdvancement));
 
     // Note if a true tie occurred
     if(!res.isComplete())
-        emit calculationDetail(LOG_EVENT_QUALIFIER_UNSUCCESSFUL);
+        TRACE(CalculationTrace::QualifierUnsuccessful);
 
     // Return the qualifier result set, ideally complete
-    logQualifierResult(res);
+    traceQualifierResult(res);
     return res;
 }
 
-bool Calculator::checkForDefactoWinner(const QString& firstSeed, const QSet<QString>& overflow) const
+bool Calculator::Context::checkForDefactoWinner(int firstSeed, const CandidateSet& overflow) const
 {
-    emit calculationDetail(LOG_EVENT_DEFACTO_WINNER_CHECK.arg(firstSeed) + '\n' + createCandidateGeneralSetString(overflow));
+    TRACE(CalculationTrace::DefactoWinnerCheck, firstSeed, overflow);
 
-    for(const QString& other : overflow)
+    for(int other : overflow)
     {
-        std::pair<QString, QString> matchup = std::make_pair(firstSeed, other);
-
-        if(performRunoff(matchup) == firstSeed)
-            emit calculationDetail(LOG_EVENT_DEFACTO_WINNER_CHECK_WIN.arg(other));
+        if(performRunoff(firstSeed, other) == firstSeed)
+            TRACE(CalculationTrace::DefactoWinnerCheckWin, other);
         else
         {
-            emit calculationDetail(LOG_EVENT_DEFACTO_WINNER_CHECK_FAIL.arg(other));
+            TRACE(CalculationTrace::DefactoWinnerCheckFail, other);
             return false;
         }
     }
 
-    emit calculationDetail(LOG_EVENT_DEFACTO_WINNER_CHECK_SUCCESS);
+    TRACE(CalculationTrace::DefactoWinnerCheckSuccess);
     return true;
 }
 
-QString Calculator::performRunoff(std::pair<QString, QString> candidates) const
+int Calculator::Context::performRunoff(int candidateA, int candidateB) const
 {
-    emit calculationDetail(LOG_EVENT_RUNOFF.arg(candidates.first, candidates.second));
+    TRACE(CalculationTrace::Runoff, candidateA, candidateB);
 
     // Check for clear winner
-    emit calculationDetail(LOG_EVENT_RUNOFF_HEAD_TO_HEAD_WINNER_CHECK);
-    QString winner = mHeadToHeadResults->winner(candidates.first, candidates.second);
-    if(winner.isNull())
+    TRACE(CalculationTrace::RunoffHeadToHeadWinnerCheck);
+    int winner = mHeadToHeadResults->winner(candidateA, candidateB);
+
+    if(winner == -1)
     {
-        emit calculationDetail(LOG_EVENT_RUNOFF_TIE);
-        QSet<QString> cTied = {candidates.first, candidates.second};
+        TRACE(CalculationTrace::RunoffTie);
+        CandidateSet cTied(mSummary.candidateCount());
+        cTied.insert(candidateA);
+        cTied.insert(candidateB);
 
         // Try to break tie by original score
-        emit calculationDetail(LOG_EVENT_RUNOFF_HIGHER_SCORE_CHECK);
-        QSet<QString> highestScore = breakTieHighestScore(cTied);
-        if(highestScore.size() == 1)
-            winner = *highestScore.cbegin();
+        TRACE(CalculationTrace::RunoffHigherScoreCheck);
+        CandidateSet highestScore = breakTieHighestScore(cTied);
+        if(highestScore.count() == 1)
+            winner = highestScore.first();
         else
         {
             // Try to break tie by five star votes
-            emit calculationDetail(LOG_EVENT_RUNOFF_MORE_FIVE_STAR_CHECK);
-            QSet<QString> mostFiveStar = breakTieMostFiveStar(cTied);
-            if(mostFiveStar.size() == 1)
-                winner = *mostFiveStar.cbegin();
+            TRACE(CalculationTrace::RunoffMoreFiveStarCheck);
+            CandidateSet mostFiveStar = breakTieMostFiveStar(cTied);
+            if(mostFiveStar.count() == 1)
+                winner = mostFiveStar.first();
             else
             {
                 // Randomly choose a winner if allowed
                 if(!mOptions.testFlag(Option::AllowTrueTies))
                 {
-                    emit calculationDetail(LOG_EVENT_RUNOFF_CHOOSING_RANDOM_WINNER);
+                    TRACE(CalculationTrace::RunoffChoosingRandomWinner);
                     winner = breakTieRandom(cTied);
                 }
                 else
-                    emit calculationDetail(LOG_EVENT_RUNOFF_NO_RANDOM);
+                    TRACE(CalculationTrace::RunoffNoRandom);
             }
         }
     }
 
     // Note results
-    emit calculationDetail(winner.isNull() ? LOG_EVENT_RUNOFF_UNRESOLVED : LOG_EVENT_RUNOFF_WINNER.arg(winner));
+    if(winner == -1)
+        TRACE(CalculationTrace::RunoffUnresolved);
+    else
+        TRACE(CalculationTrace::RunoffWinner, winner);
 
     // Return result
     return winner;
 }
 
-QList<Rank> Calculator::rankByScore(const QSet<QString>& candidates, Rank::Order order) const
+qsizetype Calculator::Context::rankDepth(qsizetype needed) const
+{
+    // Decisions only ever look at the leading ranks, but the trace shows them in full
+    return mTracing ? RankSorter::ALL_RANKS : needed;
+}
+
+QList<CandidateRank> Calculator::Context::candidateRanks(const QList<Rank>& rankings) const
+{
+    QList<CandidateRank> ranks;
+    ranks.reserve(rankings.size());
+    for(const Rank& r : rankings)
+    {
+        CandidateRank& rank = ranks.emplaceBack(CandidateRank{.value = r.value, .candidates = CandidateSet(mSummary.candidateCount())});
+        for(const QString& c : r.candidates)
+            rank.candidates.insert(mSummary.candidateId(c));
+    }
+
+    return ranks;
+}
+
+QSet<QString> Calculator::Context::candidateNames(const CandidateSet& candidates) const
+{
+    QSet<QString> names;
+    for(int id : candidates)
+        names.insert(mSummary.candidateName(id));
+
+    return names;
+}
+
+QList<CandidateRank> Calculator::Context::rankByScore(const CandidateSet& candidates, Rank::Order order, qsizetype maxRanks) const
 {
     /* Determine aggregate score of candidate list
      * Redoing this with the provided sub-list is more straight forward than trying to manipulate
      * the full score rankings that are part of the Election
      */
-    emit calculationDetail(LOG_EVENT_RANK_BY_SCORE.arg(ENUM_NAME(order)));
-    QMap<QString, int> totalScoreMap;
+    TRACE(CalculationTrace::RankByScore, order);
+    RankSorter sorter;
 
-    for(const QString& candidate : candidates)
-        totalScoreMap[candidate] = mElection->totalScore(candidate);
+    for(int id : candidates)
+        sorter.add(id, mSummary.totalScore(id));
 
     // Create sorted rank list
-    QList<Rank> scoreRanks = Rank::rankSort(totalScoreMap, order);
+    QList<CandidateRank> scoreRanks = sorter.sortIds(int(mSummary.candidateCount()), order, maxRanks);
 
-    emit calculationDetail(LOG_EVENT_RANKINGS_SCORE + '\n' + createCandidateRankListString(scoreRanks));
+    TRACE(CalculationTrace::ScoreRankings, scoreRanks);
     return scoreRanks;
 }
 
-QList<Rank> Calculator::rankByVotesOfMaxScore(const QSet<QString>& candidates, Rank::Order order) const
+QList<CandidateRank> Calculator::Context::rankByVotesOfMaxScore(const CandidateSet& candidates, Rank::Order order, qsizetype maxRanks) const
 {
     // Determine aggregate max votes of candidate list
-    emit calculationDetail(LOG_EVENT_RANK_BY_VOTES_OF_MAX_SCORE.arg(ENUM_NAME(order)));
-    QMap<QString, int> totalMaxVotesMap;
+    TRACE(CalculationTrace::RankByVotesOfMaxScore, order);
+    RankSorter sorter;
 
-    for(const QString& candidate : candidates)
-    {
-        uint maxVoteCount = 0;
-
-        for(const Star::Election::Ballot& ballot : mElection->ballots())
-            if(ballot.score(candidate) == 5)
-                maxVoteCount++;
-
-        totalMaxVotesMap[candidate] = maxVoteCount;
-    }
+    for(int id : candidates)
+        sorter.add(id, mSummary.statistics(id).count(Election::ScoreStatistics::MAX_SCORE));
 
     // Create sorted rank list
-    QList<Rank> maxVoteRanks = Rank::rankSort(totalMaxVotesMap, order);
+    QList<CandidateRank> maxVoteRanks = sorter.sortIds(int(mSummary.candidateCount()), order, maxRanks);
 
-    emit calculationDetail(LOG_EVENT_RANKINGS_VOTES_OF_MAX_SCORE + '\n' + createCandidateRankListString(maxVoteRanks));
+    TRACE(CalculationTrace::VotesOfMaxScoreRankings, maxVoteRanks);
     return maxVoteRanks;
 }
 
-QList<Rank> Calculator::rankByHeadToHeadLosses(const QSet<QString>& candidates, const HeadToHeadResults* hth, Rank::Order order) const
+QList<CandidateRank> Calculator::Context::rankByHeadToHeadLosses(const CandidateSet& candidates, Rank::Order order, qsizetype maxRanks) const
 {
-    // Create losses map
-    emit calculationDetail(LOG_EVENT_RANK_BY_HEAD_TO_HEAD_LOSSES.arg(ENUM_NAME(order)));
-    QMap<QString, int> losses;
+    // Tally losses, only considering matchups within the candidate set
+    TRACE(CalculationTrace::RankByHeadToHeadLosses, order);
+    RankSorter sorter;
 
-    for(const QString& c : candidates)
-        losses[c] = hth->losses(c);
+    for(int id : candidates)
+        sorter.add(id, mHeadToHeadResults->losses(id, candidates));
 
     // Create sorted wins losses list
-    QList<Rank> headToHeadLossesRanks = Rank::rankSort(losses, order);
+    QList<CandidateRank> headToHeadLossesRanks = sorter.sortIds(int(mSummary.candidateCount()), order, maxRanks);
 
-    emit calculationDetail(LOG_EVENT_RANKINGS_HEAD_TO_HEAD_LOSSES + '\n' + createCandidateRankListString(headToHeadLossesRanks));
+    TRACE(CalculationTrace::HeadToHeadLossesRankings, headToHeadLossesRanks);
     return headToHeadLossesRanks;
 }
 
-QList<Rank> Calculator::rankByHeadToHeadPreferences(const QSet<QString>& candidates, const HeadToHeadResults* hth, Rank::Order order) const
+QList<CandidateRank> Calculator::Context::rankByHeadToHeadPreferences(const CandidateSet& candidates, Rank::Order order, qsizetype maxRanks) const
 {
     // Determine aggregate face-off wins of candidates list
-    emit calculationDetail(LOG_EVENT_RANK_BY_HEAD_TO_HEAD_PREFERENCES.arg(ENUM_NAME(order)));
+    TRACE(CalculationTrace::RankByHeadToHeadPreferences, order);
 
-    // Create pref count map
-    QMap<QString, int> preferences;
-    for(const QString& c : candidates)
-        preferences[c] = hth->preferences(c);
+    // Tally preference counts, only considering matchups within the candidate set
+    RankSorter sorter;
+    for(int id : candidates)
+        sorter.add(id, mHeadToHeadResults->preferences(id, candidates));
 
     // Create scoped & sorted wins list
-    QList<Rank> headToHeadPrefCountRanks = Rank::rankSort(preferences, order);
+    QList<CandidateRank> headToHeadPrefCountRanks = sorter.sortIds(int(mSummary.candidateCount()), order, maxRanks);
 
-    emit calculationDetail(LOG_EVENT_RANKINGS_HEAD_TO_HEAD_PREFERENCES + '\n' + createCandidateRankListString(headToHeadPrefCountRanks));
+    TRACE(CalculationTrace::HeadToHeadPreferencesRankings, headToHeadPrefCountRanks);
     return headToHeadPrefCountRanks;
 }
 
-QList<Rank> Calculator::rankByHeadToHeadMargin(const QSet<QString>& candidates, const HeadToHeadResults* hth, Rank::Order order) const
+QList<CandidateRank> Calculator::Context::rankByHeadToHeadMargin(const CandidateSet& candidates, Rank::Order order, qsizetype maxRanks) const
 {
     // Determine aggregate face-off wins of candidates list
-    emit calculationDetail(LOG_EVENT_RANK_BY_HEAD_TO_HEAD_MARGIN.arg(ENUM_NAME(order)));
+    TRACE(CalculationTrace::RankByHeadToHeadMargin, order);
 
-    // Create pref count map
-    QMap<QString, int> margins;
-    for(const QString& c : candidates)
-        margins[c] = hth->margin(c);
+    // Tally margins, only considering matchups within the candidate set
+    RankSorter sorter;
+    for(int id : candidates)
+        sorter.add(id, mHeadToHeadResults->margin(id, candidates));
 
     // Create scoped & sorted wins list
-    QList<Rank> headToHeadMarginRanks = Rank::rankSort(margins, order);
+    QList<CandidateRank> headToHeadMarginRanks = sorter.sortIds(int(mSummary.candidateCount()), order, maxRanks);
 
-    emit calculationDetail(LOG_EVENT_RANKINGS_HEAD_TO_HEAD_MARGIN + '\n' + createCandidateRankListString(headToHeadMarginRanks));
+    TRACE(CalculationTrace::HeadToHeadMarginRankings, headToHeadMarginRanks);
     return headToHeadMarginRanks;
 }
 
-QSet<QString> Calculator::rankBasedTiebreak(const QList<Rank>& rankings, const QString& note) const
+CandidateSet Calculator::Context::rankBasedTiebreak(const QList<CandidateRank>& rankings) const
 {
     // Break a tie by using the provided rankings
-    emit calculationDetail(note);
-    QSet<QString> tieBreak = rankings.front().candidates;
+    CandidateSet tieBreak = rankings.front().candidates;
 
-    emit calculationDetail(LOG_EVENT_BREAK_RESULT.arg(Qx::String::join(tieBreak, ", ")));
+    TRACE(CalculationTrace::BreakResult, tieBreak);
     return tieBreak;
 }
 
-QSet<QString> Calculator::breakTieMostFiveStar(const QSet<QString>& candidates) const
+CandidateSet Calculator::Context::breakTieMostFiveStar(const CandidateSet& candidates) const
 {
-    return rankBasedTiebreak(rankByVotesOfMaxScore(candidates, Rank::Descending), LOG_EVENT_BREAK_TIE_MOST_FIVE_STAR.arg(candidates.size()));
+    QList<CandidateRank> rankings = rankByVotesOfMaxScore(candidates, Rank::Descending, rankDepth(1));
+    TRACE(CalculationTrace::BreakTieMostFiveStar, candidates.count());
+    return rankBasedTiebreak(rankings);
 }
 
-QSet<QString> Calculator::breakTieHighestScore(const QSet<QString>& candidates) const
+CandidateSet Calculator::Context::breakTieHighestScore(const CandidateSet& candidates) const
 {
-    return rankBasedTiebreak(rankByScore(candidates, Rank::Descending), LOG_EVENT_BREAK_TIE_HIGHEST_SCORE.arg(candidates.size()));
+    QList<CandidateRank> rankings = rankByScore(candidates, Rank::Descending, rankDepth(1));
+    TRACE(CalculationTrace::BreakTieHighestScore, candidates.count());
+    return rankBasedTiebreak(rankings);
 }
 
-QString Calculator::breakTieRandom(const QSet<QString>& candidates) const
+int Calculator::Context::breakTieRandom(const CandidateSet& candidates) const
 {
-    emit calculationDetail(LOG_EVENT_BREAK_TIE_RANDOM.arg(candidates.size()));
+    TRACE(CalculationTrace::BreakTieRandom, candidates.count());
 
-    /* Randomly select a winner/loser of the tiebreak
-     *
-     * There is already some level of randomness since the iteration order of a set is undefined, but this is not enough on its own.
-     */
-    quint32 selection = QRandomGenerator::global()->bounded(candidates.size());
+    // Randomly select a winner/loser of the tiebreak
+    quint32 selection = QRandomGenerator::global()->bounded(candidates.count());
 
-    auto itr = candidates.constBegin();
-    for(qsizetype i = 0; i < selection; i++)
-        itr ++;
+    auto itr = candidates.begin();
+    for(quint32 i = 0; i < selection; i++)
+        ++itr;
 
     return *itr;
 }
 
-QString Calculator::createCandidateGeneralSetString(const QSet<QString>& candidates) const
+template<typename... Payload>
+void Calculator::Context::traceEvent(CalculationTrace::Kind kind, const Payload&... payload) const
 {
-    if(candidates.isEmpty())
-        return QString();
+    mTrace.beginEvent(kind);
+    (tracePayload(payload), ...);
+    mTrace.endEvent();
 
-    return Qx::String::join(candidates, "\n", "\t- ");
+    if(mDetailsEnabled)
+        emit mCalculator->calculationDetail(mTrace.render(mTrace.count() - 1));
 }
 
-QString Calculator::createCandidateToalScoreSetString(const QSet<QString>& candidates) const
-{
-    if(candidates.isEmpty())
-        return QString();
-
-    QString listStr;
-
-    auto itr = candidates.constBegin();
-    while(itr != candidates.constEnd())
-    {
-        const QString& candidate = *itr;
-        QString candidateStr = LIST_ITEM_CANDIDATE_TOTAL_SCORE.arg(candidate).arg(mElection->totalScore(candidate));
+void Calculator::Context::tracePayload(const QString& candidate) const { mTrace.appendValue(mSummary.candidateId(candidate)); }
 
-        if(++itr != candidates.constEnd())
-            candidateStr += '\n';
-        listStr.append(candidateStr);
-    }
-
-    return listStr;
+void Calculator::Context::tracePayload(const QSet<QString>& candidates) const
+{
+    mTrace.appendValue(candidates.size());
+    for(const QString& c : candidates)
+        tracePayload(c);
 }
 
-QString Calculator::createCandidateRankListString(const QList<Rank>& ranks) const
+void Calculator::Context::tracePayload(const CandidateSet& candidates) const
 {
-    if(ranks.isEmpty())
-        return QString();
-
-    QString listStr;
-    qsizetype lastIdx = ranks.size() - 1;
-    for(qsizetype i = 0; i < ranks.size(); i++)
-    {
-        const Rank& rank = ranks.at(i);
-        QString candidateStr = LIST_ITEM_RANK.arg(i).arg(Qx::String::join(rank.candidates, R"(", ")")).arg(rank.value);
-        if(i != lastIdx)
-            candidateStr += '\n';
-        listStr.append(candidateStr);
-    }
-
-    return listStr;
+    mTrace.appendValue(candidates.count());
+    for(int id : candidates)
+        mTrace.appendValue(id);
 }
 
-void Calculator::logQualifierResult(const QualifierResult& result) const
+void Calculator::Context::tracePayload(const QStringList& candidates) const
 {
-    QString strFs = !result.hasFirstSeed() ? "" : '"' + result.firstSeed() + '"';
-    QString strSs = !result.hasSecondSeed() ? "" : '"' + result.secondSeed() + '"';
-    QString strOf = result.isComplete() ? "" : '"' + Qx::String::join(result.overflow(), R"(", ")") + '"';
-
-    // Log
-    emit calculationDetail(LOG_EVENT_QUALIFIER_RESULT.arg(strFs, strSs, result.isSeededSimultaneously() ? "true" : "false", strOf));
+    mTrace.appendValue(candidates.size());
+    for(const QString& c : candidates)
+        tracePayload(c);
 }
 
-void Calculator::logElectionResults(const ElectionResult& results) const
+void Calculator::Context::tracePayload(const QList<CandidateRank>& ranks) const
 {
-    // Create filled seats string
-    QString seatListStr;
-    const QStringList cWinners = results.winners();
-
-    if(cWinners.isEmpty())
-        seatListStr = LIST_ITEM_NONE + '\n';
-    else
+    mTrace.appendValue(ranks.size());
+    for(const CandidateRank& r : ranks)
     {
-        for(qsizetype i = 0; i < results.winners().size(); i++)
-        {
-            QString seatWinner = results.winners().at(i);
-            QString seatStr = LIST_ITEM_SEAT.arg(i).arg(seatWinner);
-            seatStr += '\n';
-            seatListStr.append(seatStr);
-        }
+        mTrace.appendValue(r.value);
+        tracePayload(r.candidates);
     }
+}
 
-    // Create unresolved candidates string
-    QString unresolvedListStr;
-    const QSet<QString> cUnresolved = results.unresolvedCandidates();
-
-    if(cUnresolved.isEmpty())
-        unresolvedListStr = LIST_ITEM_NONE + '\n';
-    else
-    {
-        for(auto itr = cUnresolved.cbegin(); itr != cUnresolved.cend(); itr++)
-        {
-            QString candidate = *itr;
-            QString unresolvedStr = LIST_ITEM_UNRESOLVED.arg(candidate);
-            unresolvedStr += '\n';
-            unresolvedListStr.append(unresolvedStr);
-        }
-    }
+void Calculator::Context::tracePayload(Rank::Order order) const { mTrace.appendValue(order); }
 
-    // Log
-    emit calculationDetail(LOG_EVENT_FINAL_RESULTS.arg(seatListStr, unresolvedListStr).arg(results.unfilledSeatCount()));
+void Calculator::Context::traceQualifierResult(const QualifierResult& result) const
+{
+    TRACE(CalculationTrace::QualifierResult, result.firstSeed(), result.secondSeed(), result.isSeededSimultaneously(),
+          result.isComplete(), result.isComplete() ? QSet<QString>() : result.overflow());
 }
 
-//Public:
-/*!
- *  Returns the current election that the calculator is set to evaluate, or @c nullptr if none is set.
- *
- *  @sa Calculator(), and setElection().
- */
-const Election* Calculator::election() const { return mElection; }
+void Calculator::Context::traceElectionResults(const ElectionResult& results) const
+{
+    TRACE(CalculationTrace::FinalResults, results.winners(), results.unresolvedCandidates(), results.unfilledSeatCount());
+}
 
-/*!
- *  Returns the current option set of the calculator.
- *
- *  @sa setOptions().
- */
-Calculator::Options Calculator::options() const { return mOptions; }
+bool Calculator::Context::isCanceled() const { return mPromise && mPromise->isCanceled(); }
 
-/*!
- *  Sets the calculator to evaluate the Election @a election.
- *
- *  @sa election().
- */
-void Calculator::setElection(const Election* election) { mElection = election; }
+void Calculator::Context::reportProgress() const
+{
+    if(!mPromise)
+        return;
 
-/*!
- *  Sets the calculator options set to @a options.
- *
- *  @sa options().
- */
-void Calculator::setOptions(Options options) { mOptions = options; }
+    // Pairs are tallied lazily, so the progress only reaches its end once all seats are filled
+    QString text = PROGRESS_TEXT.arg(mPairsTallied).arg(mPairCount).arg(mSeatsFilled).arg(mSummary.seatCount());
+    mPromise->setProgressValueAndText(int(mPairsTallied + mSeatsFilled), text);
+}
 
-/*!
- *  Determines the outcome of the currently set election in accordance with the current options set
- *  and returns it as an ElectionResult.
- *
- *  If no election is set or the current one is invalid, a null ElectionResult is returned.
- *
- *  @sa isNull() and calculationDetail.
- */
-ElectionResult Calculator::calculateResult()
+//Public:
+ElectionResult Calculator::Context::calculate()
 {
-    // Check for valid election
-    if(!mElection || !mElection->isValid())
+    // Check for valid election, which can only be evaluated without ballots if its preferences are known
+    if(!mSummary.isValid() || (!mBallots && !mSummary.hasPreferences()))
     {
-        emit calculationDetail(LOG_EVENT_INVALID_ELECTION);
+        TRACE(CalculationTrace::InvalidElection);
         return ElectionResult();
     }
 
     // Log start
-    emit calculationDetail(LOG_EVENT_CALC_START.arg(mElection->name()) + '\n' + QString(120,'#'));
+    TRACE(CalculationTrace::CalculationStart);
 
     // Note counts
-    emit calculationDetail(LOG_EVENT_INPUT_COUNTS.arg(mElection->candidates().size())
-                                                 .arg(mElection->ballots().size())
-                                                 .arg(mElection->seatCount()));
+    TRACE(CalculationTrace::InputCounts, mSummary.candidateCount(), mSummary.ballotCount(), mSummary.seatCount());
+
+    // Active candidate rankings, which are only named again once results are reported
+    QList<CandidateRank> candidateRankings = candidateRanks(mSummary.scoreRankings());
 
     // Print out raw score rankings
-    emit calculationDetail(LOG_EVENT_INITAL_RAW_RANKINGS + '\n' + createCandidateRankListString(mElection->scoreRankings()));
+    TRACE(CalculationTrace::InitialScoreRankings, candidateRankings);
 
-    // Pre-calculate head-to-heads
-    emit calculationDetail(LOG_EVENT_CALC_HEAD_TO_HEAD);
-    mHeadToHeadResults = std::make_unique<HeadToHeadResults>(mElection);
+    // Prepare head-to-heads, which are each only tallied once first needed
+    TRACE(CalculationTrace::HeadToHeadPrecalculation);
+    mHeadToHeadResults = std::make_unique<HeadToHeadResults>(mSummary, mBallots, mThreadCount);
+
+    // Report each matchup tallied, stopping the pairwise pass short if the calculation is canceled
+    if(mPromise)
+    {
+        mPairCount = mHeadToHeadResults->untalliedCount();
+        mPromise->setProgressRange(0, int(mPairCount + mSummary.seatCount()));
+        reportProgress();
+
+        mHeadToHeadResults->setCheckpoint([this](qsizetype tallied){
+            mPairsTallied = tallied;
+            reportProgress();
+            if(!isCanceled())
+                return true;
+
+            // Nothing determined from here on is meaningful, so none of it may be reported either
+            mTracing = false;
+            return false;
+        });
+    }
 
     // Results holder
     QList<Seat> processedSeats;
 
-    // Active candidate rankings
-    QList<Rank> candidateRankings = mElection->scoreRankings();
-
-    for(int s = 0; s < mElection->seatCount(); s++)
+    for(int s = 0; s < mSummary.seatCount(); s++)
     {
-        emit calculationDetail(LOG_EVENT_FILLING_SEAT.arg(s));
+        // Abandon the calculation between seats if canceled
+        mSeatsFilled = s;
+        reportProgress();
+        if(isCanceled())
+            return ElectionResult();
+
+        TRACE(CalculationTrace::FillingSeat, s);
 
         // Handle case of only one candidate remaining
         if(candidateRankings.size() == 1)
         {
-            const QSet<QString>& frontCandidates = candidateRankings.at(0).candidates;
-            if(frontCandidates.size() == 1)
+            const CandidateSet& frontCandidates = candidateRankings.at(0).candidates;
+            if(frontCandidates.count() == 1)
             {
-                emit calculationDetail(LOG_EVENT_DIRECT_SEAT_FILL);
-                processedSeats.append(Seat(*frontCandidates.cbegin()));
+                TRACE(CalculationTrace::DirectSeatFill);
+                processedSeats.append(Seat(mSummary.candidateName(frontCandidates.first())));
                 break;
             }
         }
 
-        QString seatWinner;
+        int seatWinner = -1;
 
         // Determine scoring round leaders based on raw score
-        QualifierResult runoffQualifier = performRunoffQualifier(candidateRankings);
+        auto [firstAdvancement, secondAdvancement] = performRunoffQualifier(candidateRankings);
+        if(isCanceled())
+            return ElectionResult();
+
+        QualifierResult runoffQualifier = qualifierResult(firstAdvancement, secondAdvancement);
 
         // Check for an unresolved scoring round tie that prevented a runoff
         if(!runoffQualifier.isComplete())
         {
-            emit calculationDetail(LOG_EVENT_NO_RUNOFF);
+            TRACE(CalculationTrace::NoRunoff);
 
-            // Check if runoff sim is possible
+            // Check if runoff sim is possible, in which case the first seed was advanced alone and the rest tied for second
             if(mOptions.testFlag(Option::DefactoWinner) && runoffQualifier.hasFirstSeed())
             {
-                if(checkForDefactoWinner(runoffQualifier.firstSeed(), runoffQualifier.overflow()))
-                    seatWinner = runoffQualifier.firstSeed();
+                int firstSeed = firstAdvancement.first();
+                if(checkForDefactoWinner(firstSeed, secondAdvancement))
+                    seatWinner = firstSeed;
 
-                emit calculationDetail(LOG_EVENT_DEFACTO_WINNER_SEAT_FILL.arg(seatWinner));
+                TRACE(CalculationTrace::DefactoWinnerSeatFill, seatWinner);
             }
 
             // Stop election
-            processedSeats.append(Seat(seatWinner, runoffQualifier));
+            processedSeats.append(Seat(mSummary.candidateName(seatWinner), runoffQualifier));
             break;
         }
 
-        emit calculationDetail(LOG_EVENT_RUNOFF_CANDIDATES.arg(runoffQualifier.firstSeed(), runoffQualifier.secondSeed()));
+        // The seeds were either advanced together, in which case they're taken in ID order, or one at a time
+        int firstSeed = firstAdvancement.first();
+        int secondSeed = secondAdvancement.isEmpty() ? *(++firstAdvancement.begin()) : secondAdvancement.first();
+
+        TRACE(CalculationTrace::RunoffCandidates, firstSeed, secondSeed);
 
         // Perform primary runoff
-        emit calculationDetail(LOG_EVENT_PERFORM_PRIMARY_RUNOFF);
-        seatWinner = performRunoff(runoffQualifier.seeds());
+        TRACE(CalculationTrace::PrimaryRunoff);
+        seatWinner = performRunoff(firstSeed, secondSeed);
+        if(isCanceled())
+            return ElectionResult();
 
         // Check for unresolved runoff tie
-        if(seatWinner.isNull())
+        if(seatWinner == -1)
         {
             processedSeats.append(runoffQualifier);
             break;
         }
 
         // Record seat winner
-        processedSeats.append(Seat(seatWinner, runoffQualifier));
+        processedSeats.append(Seat(mSummary.candidateName(seatWinner), runoffQualifier));
 
         /* Remove seat winner from remaining rankings
          *
@@ -774,11 +1146,11 @@ ElectionResult Calculator::calculateResult()
         auto rItr = candidateRankings.begin();
         while(rItr != candidateRankings.end())
         {
-            Rank& rank = *rItr;
+            CandidateRank& rank = *rItr;
 
             if(rank.candidates.contains(seatWinner))
             {
-                if(rank.candidates.size() == 1)
+                if(rank.candidates.count() == 1)
                     candidateRankings.erase(rItr); // clazy:exclude=strict-iterators
                 else
                     rank.candidates.remove(seatWinner);
@@ -790,27 +1162,27 @@ ElectionResult Calculator::calculateResult()
         }
     }
 
-    ElectionResult finalResults(mElection, processedSeats);
+    // A pairwise pass cut short by cancellation leaves the last seat undetermined
+    if(isCanceled())
+        return ElectionResult();
+
+    mPairsTallied = mPairCount;
+    mSeatsFilled = mSummary.seatCount();
+    reportProgress();
+
+    ElectionResult finalResults = mBallots ? ElectionResult(mBallots, processedSeats) : ElectionResult(mSummary, processedSeats);
 
     // Note final results
-    logElectionResults(finalResults);
+    traceElectionResults(finalResults);
 
     // Log finish
-    emit calculationDetail(LOG_EVENT_CALC_FINISH + '\n' + QString(120,'-'));
+    TRACE(CalculationTrace::CalculationFinish);
 
     // Return final results
     return finalResults;
 }
 
-/*!
- *  @fn void Calculator::calculationDetail(const QString& detail)
- *
- *  This signal is emitted at various points during the execution of calculateResult().
- *
- *  It provides numerous details about the entire calculation process that are useful for logging and
- *  gaining insight into the STAR election procedure.
- *
- *  @sa calculateResult().
- */
+CalculationTrace Calculator::Context::takeTrace() { return std::move(mTrace); }
 
+/*! @endcond */
 }
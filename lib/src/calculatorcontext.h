@@ -0,0 +1,100 @@
+#ifndef CALCULATORCONTEXT_H
+#define CALCULATORCONTEXT_H
+
+// Standard Library Includes
+#include <concepts>
+#include <memory>
+
+// Qt Includes
+#include <QPromise>
+
+// Project Includes
+#include "star/calculator.h"
+#include "headtoheadresults.h"
+#include "candidateset.h"
+
+namespace Star
+{
+/*! @cond */
+
+class Calculator::Context
+{
+//-Class Variables------------------------------------------------------------------------------------------------------
+private:
+    static inline const QString PROGRESS_TEXT = QStringLiteral("Tallied %1 of %2 head-to-head matchups, filled %3 of %4 seats");
+
+//-Instance Variables--------------------------------------------------------------------------------------------------
+private:
+    const Calculator* mCalculator; // Only used to emit details
+    Options mOptions;
+    int mThreadCount;
+    ElectionSummary mSummary;
+    const Election* mBallots; // Source of preferences not already in the summary, if any
+    std::unique_ptr<HeadToHeadResults> mHeadToHeadResults;
+    bool mDetailsEnabled;
+    bool mTracing;
+    mutable CalculationTrace mTrace;
+
+    // Only used by asynchronous calculations
+    QPromise<ElectionResult>* mPromise;
+    qsizetype mPairCount;
+    qsizetype mPairsTallied;
+    int mSeatsFilled;
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+public:
+    Context(const Calculator* calculator, const ElectionSummary& summary, const Election* ballots, int threadCount,
+            bool record, bool emitDetails, QPromise<ElectionResult>* promise = nullptr);
+
+//-Instance Functions-------------------------------------------------------------------------------------------------
+private:
+    // Main steps
+    std::pair<CandidateSet, CandidateSet> performRunoffQualifier(const QList<CandidateRank>& scoreRankings) const;
+    QualifierResult qualifierResult(const CandidateSet& firstAdvancement, const CandidateSet& secondAdvancement) const;
+    bool checkForDefactoWinner(int firstSeed, const CandidateSet& overflow) const;
+    int performRunoff(int candidateA, int candidateB) const;
+
+    // Utility
+    qsizetype rankDepth(qsizetype needed) const;
+    QList<CandidateRank> candidateRanks(const QList<Rank>& rankings) const;
+    QSet<QString> candidateNames(const CandidateSet& candidates) const;
+
+    QList<CandidateRank> rankByScore(const CandidateSet& candidates, Rank::Order order, qsizetype maxRanks) const;
+    QList<CandidateRank> rankByVotesOfMaxScore(const CandidateSet& candidates, Rank::Order order, qsizetype maxRanks) const;
+    QList<CandidateRank> rankByHeadToHeadLosses(const CandidateSet& candidates, Rank::Order order, qsizetype maxRanks) const;
+    QList<CandidateRank> rankByHeadToHeadPreferences(const CandidateSet& candidates, Rank::Order order, qsizetype maxRanks) const;
+    QList<CandidateRank> rankByHeadToHeadMargin(const CandidateSet& candidates, Rank::Order order, qsizetype maxRanks) const;
+
+    CandidateSet rankBasedTiebreak(const QList<CandidateRank>& rankings) const;
+    CandidateSet breakTieMostFiveStar(const CandidateSet& candidates) const;
+    CandidateSet breakTieHighestScore(const CandidateSet& candidates) const;
+    int breakTieRandom(const CandidateSet& candidates) const;
+
+    // Progress
+    bool isCanceled() const;
+    void reportProgress() const;
+
+    // Tracing
+    template<typename... Payload>
+    void traceEvent(CalculationTrace::Kind kind, const Payload&... payload) const;
+    template<typename T>
+        requires std::integral<T>
+    void tracePayload(T value) const { mTrace.appendValue(static_cast<qint32>(value)); }
+    void tracePayload(const QString& candidate) const;
+    void tracePayload(const QSet<QString>& candidates) const;
+    void tracePayload(const CandidateSet& candidates) const;
+    void tracePayload(const QStringList& candidates) const;
+    void tracePayload(const QList<CandidateRank>& ranks) const;
+    void tracePayload(Rank::Order order) const;
+    void traceQualifierResult(const QualifierResult& result) const;
+    void traceElectionResults(const ElectionResult& results) const;
+
+public:
+    ElectionResult calculate();
+    CalculationTrace takeTrace();
+};
+
+/*! @endcond */
+}
+
+#endif // CALCULATORCONTEXT_H
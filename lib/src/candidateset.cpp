@@ -0,0 +1,178 @@
+// Unit Include
+#include "candidateset.h"
+
+// Standard Library Includes
+#include <algorithm>
+
+namespace Star
+{
+/*! @cond */
+//===============================================================================================================
+// CandidateSet
+//===============================================================================================================
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+//Public:
+CandidateSet::CandidateSet() :
+    mCapacity(0)
+{}
+
+CandidateSet::CandidateSet(int capacity, bool filled) :
+    mWords(wordCount(capacity)),
+    mCapacity(capacity)
+{
+    std::fill(mWords.begin(), mWords.end(), filled ? ~quint64(0) : quint64(0));
+
+    // Keep bits beyond the capacity clear so that counting and comparison need no masking
+    int tailBits = capacity % WORD_BITS;
+    if(filled && tailBits != 0)
+        mWords.last() = (quint64(1) << tailBits) - 1;
+}
+
+//-Class Functions----------------------------------------------------------------------------------------------------
+//Private:
+qsizetype CandidateSet::wordCount(int capacity) { return (capacity + WORD_BITS - 1) / WORD_BITS; }
+
+//-Instance Functions-------------------------------------------------------------------------------------------------
+//Public:
+int CandidateSet::capacity() const { return mCapacity; }
+
+bool CandidateSet::isEmpty() const
+{
+    return std::all_of(mWords.cbegin(), mWords.cend(), [](quint64 w){ return w == 0; });
+}
+
+int CandidateSet::count() const
+{
+    int c = 0;
+    for(quint64 w : mWords)
+        c += std::popcount(w);
+    return c;
+}
+
+bool CandidateSet::contains(int id) const
+{
+    qsizetype w = id / WORD_BITS;
+    return id >= 0 && w < mWords.size() && (mWords[w] >> (id % WORD_BITS)) & 1;
+}
+
+int CandidateSet::first() const
+{
+    const_iterator itr = begin();
+    return itr != end() ? *itr : -1;
+}
+
+void CandidateSet::insert(int id)
+{
+    Q_ASSERT(id >= 0);
+    qsizetype w = id / WORD_BITS;
+    if(w >= mWords.size())
+    {
+        qsizetype oldSize = mWords.size();
+        mWords.resize(w + 1);
+        std::fill(mWords.begin() + oldSize, mWords.end(), 0);
+    }
+
+    mWords[w] |= quint64(1) << (id % WORD_BITS);
+    mCapacity = std::max(mCapacity, id + 1);
+}
+
+void CandidateSet::remove(int id)
+{
+    qsizetype w = id / WORD_BITS;
+    if(id >= 0 && w < mWords.size())
+        mWords[w] &= ~(quint64(1) << (id % WORD_BITS));
+}
+
+void CandidateSet::clear() { std::fill(mWords.begin(), mWords.end(), 0); }
+
+CandidateSet& CandidateSet::unite(const CandidateSet& other)
+{
+    if(other.mWords.size() > mWords.size())
+    {
+        qsizetype oldSize = mWords.size();
+        mWords.resize(other.mWords.size());
+        std::fill(mWords.begin() + oldSize, mWords.end(), 0);
+    }
+
+    for(qsizetype w = 0; w < other.mWords.size(); w++)
+        mWords[w] |= other.mWords[w];
+    mCapacity = std::max(mCapacity, other.mCapacity);
+
+    return *this;
+}
+
+CandidateSet& CandidateSet::subtract(const CandidateSet& other)
+{
+    qsizetype common = std::min(mWords.size(), other.mWords.size());
+    for(qsizetype w = 0; w < common; w++)
+        mWords[w] &= ~other.mWords[w];
+
+    return *this;
+}
+
+CandidateSet& CandidateSet::intersect(const CandidateSet& other)
+{
+    for(qsizetype w = 0; w < mWords.size(); w++)
+        mWords[w] &= w < other.mWords.size() ? other.mWords[w] : 0;
+
+    return *this;
+}
+
+bool CandidateSet::operator==(const CandidateSet& other) const
+{
+    // Membership alone decides equality, so words only one side has must simply be empty
+    qsizetype common = std::min(mWords.size(), other.mWords.size());
+    if(!std::equal(mWords.cbegin(), mWords.cbegin() + common, other.mWords.cbegin()))
+        return false;
+
+    const auto& longer = mWords.size() > other.mWords.size() ? mWords : other.mWords;
+    return std::all_of(longer.cbegin() + common, longer.cend(), [](quint64 w){ return w == 0; });
+}
+
+CandidateSet::const_iterator CandidateSet::begin() const { return const_iterator(mWords.constData(), mWords.size(), 0); }
+CandidateSet::const_iterator CandidateSet::end() const { return const_iterator(mWords.constData(), mWords.size(), mWords.size()); }
+
+//===============================================================================================================
+// CandidateSet::const_iterator
+//===============================================================================================================
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+//Private:
+CandidateSet::const_iterator::const_iterator(const quint64* words, qsizetype wordCount, qsizetype wordIdx) :
+    mWords(words),
+    mWordCount(wordCount),
+    mWordIdx(wordIdx),
+    mRemaining(wordIdx < wordCount ? words[wordIdx] : 0)
+{
+    seek();
+}
+
+//-Instance Functions-------------------------------------------------------------------------------------------------
+//Private:
+void CandidateSet::const_iterator::seek()
+{
+    // Advance to the next word with a set bit, or the end
+    while(mRemaining == 0 && mWordIdx < mWordCount)
+    {
+        mWordIdx++;
+        mRemaining = mWordIdx < mWordCount ? mWords[mWordIdx] : 0;
+    }
+}
+
+//Public:
+int CandidateSet::const_iterator::operator*() const { return int(mWordIdx) * WORD_BITS + std::countr_zero(mRemaining); }
+
+CandidateSet::const_iterator& CandidateSet::const_iterator::operator++()
+{
+    mRemaining &= mRemaining - 1; // Clear lowest set bit
+    seek();
+    return *this;
+}
+
+bool CandidateSet::const_iterator::operator==(const const_iterator& other) const
+{
+    return mWordIdx == other.mWordIdx && mRemaining == other.mRemaining;
+}
+/*! @endcond */
+}
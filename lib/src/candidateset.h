@@ -0,0 +1,94 @@
+#ifndef CANDIDATESET_H
+#define CANDIDATESET_H
+
+// Standard Library Includes
+#include <bit>
+
+// Qt Includes
+#include <QVarLengthArray>
+
+namespace Star
+{
+/*! @cond */
+
+class CandidateSet
+{
+//-Inner Classes----------------------------------------------------------------------------------------------------
+public:
+    class const_iterator;
+
+//-Class Variables------------------------------------------------------------------------------------------------------
+private:
+    static const int WORD_BITS = 64;
+    static const int INLINE_WORDS = 4; // Sets of up to 256 candidates never allocate
+
+//-Instance Variables--------------------------------------------------------------------------------------------------
+private:
+    QVarLengthArray<quint64, INLINE_WORDS> mWords;
+    int mCapacity; // Candidates the set covers, which the words may exceed
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+public:
+    CandidateSet();
+    explicit CandidateSet(int capacity, bool filled = false);
+
+//-Class Functions----------------------------------------------------------------------------------------------------
+private:
+    static qsizetype wordCount(int capacity);
+
+//-Instance Functions-------------------------------------------------------------------------------------------------
+public:
+    int capacity() const;
+    bool isEmpty() const;
+    int count() const;
+    bool contains(int id) const;
+    int first() const;
+
+    void insert(int id);
+    void remove(int id);
+    void clear();
+
+    CandidateSet& unite(const CandidateSet& other);
+    CandidateSet& subtract(const CandidateSet& other);
+    CandidateSet& intersect(const CandidateSet& other);
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    bool operator==(const CandidateSet& other) const;
+};
+
+class CandidateSet::const_iterator
+{
+    friend class CandidateSet;
+//-Instance Variables--------------------------------------------------------------------------------------------------
+private:
+    const quint64* mWords;
+    qsizetype mWordCount;
+    qsizetype mWordIdx;
+    quint64 mRemaining; // Bits of the current word not yet visited
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+private:
+    const_iterator(const quint64* words, qsizetype wordCount, qsizetype wordIdx);
+
+//-Instance Functions-------------------------------------------------------------------------------------------------
+private:
+    void seek();
+
+public:
+    int operator*() const;
+    const_iterator& operator++();
+    bool operator==(const const_iterator& other) const;
+};
+
+// Counterpart of Rank that identifies candidates by ID, for use until names are needed for results
+struct CandidateRank
+{
+    int value;
+    CandidateSet candidates;
+};
+/*! @endcond */
+}
+
+#endif // CANDIDATESET_H
@@ -1,6 +1,18 @@
 // Unit Include
 #include "star/election.h"
 
+// Standard Library Includes
+#include <numeric>
+#include <algorithm>
+
+// Qt Includes
+#include <QVarLengthArray>
+
+// Project Includes
+#include "star/electionsummary.h"
+#include "ranksorter.h"
+#include "preferencematrix.h"
+
 namespace Star
 {
 
@@ -17,6 +29,61 @@ namespace Star
  *  is created via Election::Builder and then "counted" with a Calculator, which provides a corresponding
  *  ElectionResults instance.
  *
+ *  Internally, each candidate is assigned a dense integer ID that corresponds to their position within
+ *  candidates(), and all ballot scores are kept in a single contiguous candidate-major table such that the
+ *  scores given to a candidate across all ballots can be accessed as one block via scores(). The string based
+ *  functions of Election and Election::Ballot are provided for convenience and are implemented on top of this
+ *  layout.
+ *
+ *  A histogram of the scores each candidate received is also tallied while the election is built, so that
+ *  aggregate figures such as total scores or the number of five star votes are available immediately through
+ *  statistics().
+ *
+ *  @par Score Layout
+ *  @parblock
+ *  By default each score occupies a byte (Election::Bytes). Since a score never exceeds 5 it only really needs
+ *  three bits, so an election can instead be built with its scores transposed into bit planes
+ *  (Election::BitPlanes; see Election::Builder::wScoreLayout()). Each group of 64 ballots is then represented by
+ *  three 64-bit words per candidate, one for each bit of the scores, which reduces the memory used by the scores by
+ *  roughly 2.7 times. Head-to-head matchups are also tallied directly from the planes, comparing 64 ballots at a
+ *  time with a few bitwise operations.
+ *
+ *  Elections with a great number of candidates, most of whom are write-ins, are instead dominated by scores of
+ *  @c 0, since each voter only scores a handful of them. Such an election can be built with only the nonzero scores
+ *  of each ballot kept, ordered by candidate (Election::Sparse), so that the memory used by its scores depends on
+ *  the number of scores actually given rather than on the number of candidates. Head-to-head matchups are then
+ *  tallied by visiting only the candidates each ballot scored, with the preferences for scored candidates over
+ *  unscored ones derived from statistics() instead of from the implicit zeros.
+ *
+ *  The only difference to users of an election is that its scores are not available as bytes, so scores() cannot be
+ *  used, though the scores of individual ballots are still available through score() and Election::Ballot.
+ *  @endparblock
+ *
+ *  @par Weighted Ballots
+ *  @parblock
+ *  Each ballot carries a weight, which is the number of voters that cast it and is @c 1 unless specified
+ *  otherwise when the ballot is added. Statistics, head-to-head preferences and results all count a ballot
+ *  once per unit of weight, so a single ballot with a weight of @c 10 is equivalent to ten identical ballots.
+ *
+ *  Since elections with few candidates tend to contain a great number of identical ballots, the builder
+ *  can also collapse identical ballots into one weighted ballot as the election is built (see
+ *  Election::Builder::wCollapseDuplicates()). Everything that has to examine the ballots of an election
+ *  then only does so once per distinct set of scores, instead of once per voter.
+ *  @endparblock
+ *
+ *  @par Live Tally
+ *  @parblock
+ *  Although an election is normally complete once built, ballots can still be added or removed afterwards
+ *  with appendBallot() and retractBallot(), which keep the statistics and score rankings of the election up
+ *  to date as they go. This is intended for results that are re-evaluated repeatedly while ballots are still
+ *  arriving.
+ *
+ *  Enabling a live tally via enableLiveTally() additionally has the election maintain the head-to-head
+ *  preferences between every pair of candidates, at a cost of O(C²) per added or removed ballot. A Calculator
+ *  then uses those preferences directly instead of re-examining every ballot, so that calculateResult()
+ *  remains cheap regardless of the number of ballots.
+ *  @endparblock
+ *
  *  @sa Calculator.
  */
 
@@ -27,22 +94,140 @@ namespace Star
  *
  *  @sa Election::Builder.
  */
-Election::Election() {}
+Election::Election() :
+    mTotalWeight(0),
+    mScoreLayout(Bytes),
+    mScoreStride(0),
+    mSparseGarbage(0)
+{}
 
 //-Instance Functions-------------------------------------------------------------------------------------------------
+//Private:
+void Election::growScores(qsizetype stride)
+{
+    // Re-layout the table with more room after each candidate's scores
+    qsizetype ballots = ballotCount();
+
+    if(mScoreLayout == BitPlanes)
+    {
+        Q_ASSERT(stride % PLANE_WIDTH == 0);
+        qsizetype oldWords = mScoreStride / PLANE_WIDTH * PLANE_COUNT;
+        qsizetype newWords = stride / PLANE_WIDTH * PLANE_COUNT;
+        QList<quint64> grown(candidateCount() * newWords, 0);
+
+        for(qsizetype id = 0; id < candidateCount(); id++)
+        {
+            auto candidatePlanes = mScorePlanes.cbegin() + id * oldWords;
+            std::copy(candidatePlanes, candidatePlanes + oldWords, grown.begin() + id * newWords);
+        }
+
+        mScorePlanes = std::move(grown);
+        mScoreStride = stride;
+        return;
+    }
+
+    QList<quint8> grown(candidateCount() * stride, 0);
+
+    for(qsizetype id = 0; id < candidateCount(); id++)
+    {
+        auto candidateScores = mScores.cbegin() + id * mScoreStride;
+        std::copy(candidateScores, candidateScores + ballots, grown.begin() + id * stride);
+    }
+
+    mScores = std::move(grown);
+    mScoreStride = stride;
+}
+
+quint8 Election::storedScore(qsizetype id, qsizetype ballot) const
+{
+    if(mScoreLayout == Bytes)
+        return mScores.at(id * mScoreStride + ballot);
+
+    if(mScoreLayout == Sparse)
+    {
+        // Candidates that aren't listed weren't scored
+        std::span<const SparseScore> entries = sparseScores(ballot);
+        auto entry = std::lower_bound(entries.begin(), entries.end(), id, [](const SparseScore& e, qsizetype id){
+            return e.candidateId < id;
+        });
+        return entry != entries.end() && entry->candidateId == id ? entry->score : quint8(0);
+    }
+
+    const quint64* group = mScorePlanes.constData() + (id * mScoreStride + ballot) / PLANE_WIDTH * PLANE_COUNT;
+    int shift = ballot % PLANE_WIDTH;
+    quint8 score = 0;
+    for(int p = 0; p < PLANE_COUNT; p++)
+        score |= quint8(((group[p] >> shift) & 1) << p);
+
+    return score;
+}
+
+void Election::storeScore(qsizetype id, qsizetype ballot, quint8 score)
+{
+    // Sparse ballots are only ever stored whole
+    Q_ASSERT(mScoreLayout != Sparse);
+
+    if(mScoreLayout == Bytes)
+    {
+        mScores[id * mScoreStride + ballot] = score;
+        return;
+    }
+
+    quint64* group = mScorePlanes.data() + (id * mScoreStride + ballot) / PLANE_WIDTH * PLANE_COUNT;
+    quint64 bit = quint64(1) << (ballot % PLANE_WIDTH);
+    for(int p = 0; p < PLANE_COUNT; p++)
+        group[p] = (score >> p) & 1 ? group[p] | bit : group[p] & ~bit;
+}
+
+void Election::compactSparseScores()
+{
+    // Drop the entries left behind by retracted ballots, which also restores the ballot order of the entries
+    QList<SparseScore> compacted;
+    compacted.reserve(mSparseScores.size() - mSparseGarbage);
+
+    for(qsizetype b = 0; b < ballotCount(); b++)
+    {
+        std::span<const SparseScore> entries = sparseScores(b);
+        mSparseOffsets[b] = compacted.size();
+        compacted.append(entries.begin(), entries.end());
+    }
+
+    mSparseScores = std::move(compacted);
+    mSparseGarbage = 0;
+}
+
+void Election::rankScores()
+{
+    RankSorter sorter;
+    sorter.reserve(candidateCount());
+    for(int id = 0; id < candidateCount(); id++)
+        sorter.add(id, mStatistics.at(id).totalScore());
+
+    mScoreRankings = sorter.sort(mCandidates, Rank::Descending);
+}
+
+PreferenceMatrix& Election::liveMatrix()
+{
+    // Copies of an election, and its summaries, share the matrix until the election changes
+    if(mLiveMatrix.use_count() > 1)
+        mLiveMatrix = std::make_shared<PreferenceMatrix>(*mLiveMatrix);
+
+    return *mLiveMatrix;
+}
+
 //Public:
 /*!
  *  Returns @c true if the election is valid; otherwise, returns false.
  *
  *  In order for an election to be valid, it must:
  *  @li Have two or more candidates
- *  @li Have two or more ballots
+ *  @li Have two or more ballots, counting each ballot by its weight
  *  @li Have a seat count of one or greater
  *  @li Have a seat count that is less than or equal to its number of candidates
  */
 bool Election::isValid() const
 {
-    return candidates().count() > 1 && ballots().count() > 1 && seatCount() > 0 && seatCount() <= candidates().count();
+    return candidateCount() > 1 && totalWeight() > 1 && seatCount() > 0 && seatCount() <= candidateCount();
 }
 
 /*!
@@ -52,28 +237,230 @@ QString Election::name() const { return mName; }
 
 /*!
  *  Returns the list of candidates in the election.
+ *
+ *  The position of each candidate within the list is equivalent to their ID.
+ *
+ *  @sa candidateId().
  */
-QStringList Election::candidates() const { return mTotals.keys(); }
+QStringList Election::candidates() const { return mCandidates; }
+
+/*!
+ *  Returns the number of candidates in the election.
+ */
+qsizetype Election::candidateCount() const { return mCandidates.size(); }
+
+/*!
+ *  Returns the ID of @a candidate, or @c -1 if the candidate is not part of the election.
+ *
+ *  @sa candidateName().
+ */
+int Election::candidateId(const QString& candidate) const { return mCandidateIds.value(candidate, -1); }
+
+/*!
+ *  Returns the name of the candidate with ID @a id.
+ *
+ *  @sa candidateId().
+ */
+QString Election::candidateName(int id) const { return mCandidates.value(id); }
 
 /*!
  *  Returns the list of ballots provided for the election.
+ *
+ *  Since ballots are not stored as such, the list is assembled anew on every call, so iterating over
+ *  ballotCount() with ballotAt() should be preferred where the list itself isn't needed. The returned
+ *  ballots are views into the election and are subject to the same rules as any other Election::Ballot.
+ *
+ *  @warning Before scores were stored as a table, this returned a reference to a list of ballots that
+ *  owned their votes. Code that kept ballots beyond the lifetime of their election must copy what it
+ *  needs out of them instead.
+ *
+ *  @sa ballotAt().
  */
-const QList<Election::Ballot>& Election::ballots() const { return mBallots; }
+QList<Election::Ballot> Election::ballots() const
+{
+    QList<Ballot> bl;
+    bl.reserve(ballotCount());
+    for(qsizetype i = 0; i < ballotCount(); i++)
+        bl.append(Ballot(this, i));
+
+    return bl;
+}
+
+/*!
+ *  Returns the ballot at index @a i.
+ *
+ *  The returned ballot is a view into the election, so see Election::Ballot for how long it remains valid.
+ *
+ *  @sa ballots().
+ */
+Election::Ballot Election::ballotAt(qsizetype i) const
+{
+    Q_ASSERT_X(size_t(i) < size_t(ballotCount()), "Election::ballotAt", "index out of range");
+    return Ballot(this, i);
+}
+
+/*!
+ *  Returns the number of ballots provided for the election.
+ *
+ *  Each ballot is counted once regardless of its weight, so this is the number of entries in the score
+ *  table of the election rather than the number of voters.
+ *
+ *  @sa totalWeight().
+ */
+qsizetype Election::ballotCount() const { return mVoters.size(); }
+
+/*!
+ *  Returns @c true if the election keeps the weight of each ballot individually, which is the case once
+ *  any of its ballots has a weight other than @c 1; otherwise, returns @c false.
+ *
+ *  @sa weights().
+ */
+bool Election::isWeighted() const { return !mWeights.isEmpty(); }
+
+/*!
+ *  Returns the weight of the ballot at index @a i.
+ *
+ *  @sa Ballot::weight().
+ */
+int Election::ballotWeight(qsizetype i) const
+{
+    Q_ASSERT_X(size_t(i) < size_t(ballotCount()), "Election::ballotWeight", "index out of range");
+    return mWeights.isEmpty() ? 1 : mWeights.at(i);
+}
+
+/*!
+ *  Returns the weights of all ballots, ordered by ballot, or an empty span if the election is not weighted,
+ *  in which case every ballot has a weight of @c 1.
+ *
+ *  @sa isWeighted() and scores().
+ */
+std::span<const int> Election::weights() const { return std::span<const int>(mWeights.constData(), mWeights.size()); }
+
+/*!
+ *  Returns the sum of the weights of all ballots, which is the number of voters the election represents.
+ *
+ *  @sa ballotCount().
+ */
+qsizetype Election::totalWeight() const { return mTotalWeight; }
 
 /*!
  *  Returns the number of seats prescribed for the election.
  */
 int Election::seatCount() const { return mSeats; }
 
+/*!
+ *  Returns the layout in which the scores of the election are stored.
+ *
+ *  @sa Builder::wScoreLayout().
+ */
+Election::ScoreLayout Election::scoreLayout() const { return mScoreLayout; }
+
+/*!
+ *  Returns the score given to the candidate with ID @a candidateId on the ballot at index @a ballot.
+ *
+ *  This is available regardless of the layout of the election's scores.
+ *
+ *  @sa scores() and Ballot::score().
+ */
+int Election::score(int candidateId, qsizetype ballot) const
+{
+    Q_ASSERT_X(size_t(candidateId) < size_t(candidateCount()), "Election::score", "id out of range");
+    Q_ASSERT_X(size_t(ballot) < size_t(ballotCount()), "Election::score", "ballot out of range");
+    return storedScore(candidateId, ballot);
+}
+
+/*!
+ *  Returns the scores given to the candidate with ID @a candidateId across all ballots, ordered by ballot.
+ *
+ *  The scores are only stored this way if the layout of the election is Election::Bytes; otherwise, an
+ *  empty span is returned.
+ *
+ *  @sa ballotCount(), scoreLayout(), scorePlanes() and sparseScores().
+ */
+std::span<const quint8> Election::scores(int candidateId) const
+{
+    Q_ASSERT_X(size_t(candidateId) < size_t(candidateCount()), "Election::scores", "id out of range");
+    Q_ASSERT_X(mScoreLayout == Bytes, "Election::scores", "scores are not stored as bytes");
+    if(mScoreLayout != Bytes)
+        return {};
+
+    return std::span<const quint8>(mScores.constData() + candidateId * mScoreStride, ballotCount());
+}
+
+/*!
+ *  Returns the scores given to the candidate with ID @a candidateId across all ballots as bit planes.
+ *
+ *  Every 64 ballots, in order, are represented by three consecutive words that hold bit 0, 1 and 2 of their
+ *  scores respectively, with the score of the first of those ballots in the least significant bit of each word.
+ *  The final group of words is padded with scores of @c 0 when the number of ballots is not a multiple of 64.
+ *
+ *  The scores are only stored this way if the layout of the election is Election::BitPlanes; otherwise, an
+ *  empty span is returned.
+ *
+ *  @sa scoreLayout() and scores().
+ */
+std::span<const quint64> Election::scorePlanes(int candidateId) const
+{
+    Q_ASSERT_X(size_t(candidateId) < size_t(candidateCount()), "Election::scorePlanes", "id out of range");
+    Q_ASSERT_X(mScoreLayout == BitPlanes, "Election::scorePlanes", "scores are not stored as bit planes");
+    if(mScoreLayout != BitPlanes)
+        return {};
+
+    qsizetype groupCount = (ballotCount() + PLANE_WIDTH - 1) / PLANE_WIDTH;
+    const quint64* planes = mScorePlanes.constData() + candidateId * (mScoreStride / PLANE_WIDTH * PLANE_COUNT);
+    return std::span<const quint64>(planes, groupCount * PLANE_COUNT);
+}
+
+/*!
+ *  Returns the nonzero scores given on the ballot at index @a ballot, ordered by candidate ID. Every candidate
+ *  that isn't present received a score of @c 0.
+ *
+ *  The scores are only stored this way if the layout of the election is Election::Sparse; otherwise, an
+ *  empty span is returned.
+ *
+ *  @sa scoreLayout() and score().
+ */
+std::span<const Election::SparseScore> Election::sparseScores(qsizetype ballot) const
+{
+    Q_ASSERT_X(size_t(ballot) < size_t(ballotCount()), "Election::sparseScores", "ballot out of range");
+    Q_ASSERT_X(mScoreLayout == Sparse, "Election::sparseScores", "scores are not stored sparsely");
+    if(mScoreLayout != Sparse)
+        return {};
+
+    return std::span<const SparseScore>(mSparseScores.constData() + mSparseOffsets.at(ballot), mSparseCounts.at(ballot));
+}
+
 /*!
  * Returns the total score for candidate @a candidate across all ballots.
  */
 int Election::totalScore(const QString& candidate) const
 {
-    if(!mTotals.contains(candidate))
+    int id = candidateId(candidate);
+    if(id == -1)
+    {
         qWarning("the desired candidate is not present.");
+        return 0;
+    }
 
-    return mTotals.value(candidate, 0);
+    return totalScore(id);
+}
+
+/*!
+ *  @overload
+ *
+ *  Returns the total score for the candidate with ID @a candidateId across all ballots.
+ */
+int Election::totalScore(int candidateId) const { return mStatistics.value(candidateId).totalScore(); }
+
+/*!
+ *  Returns the score statistics of the candidate with ID @a candidateId.
+ *
+ *  @sa ScoreStatistics.
+ */
+const Election::ScoreStatistics& Election::statistics(int candidateId) const
+{
+    Q_ASSERT_X(size_t(candidateId) < size_t(candidateCount()), "Election::statistics", "id out of range");
+    return mStatistics.at(candidateId);
 }
 
 /*!
@@ -81,6 +468,190 @@ int Election::totalScore(const QString& candidate) const
  */
 const QList<Rank>& Election::scoreRankings() const { return mScoreRankings; }
 
+/*!
+ *  Returns the summary of the election, which holds only the figures needed to determine its outcome.
+ *
+ *  The summary shares its data with the election, so this is cheap. The head-to-head preferences of the
+ *  election are only included if it has a live tally, as they would otherwise need to be determined
+ *  from every ballot.
+ *
+ *  @sa ElectionSummary and enableLiveTally().
+ */
+ElectionSummary Election::summary() const
+{
+    ElectionSummary summary;
+    summary.mName = mName;
+    summary.mCandidates = mCandidates;
+    summary.mCandidateIds = mCandidateIds;
+    summary.mSeats = mSeats;
+    summary.mBallotCount = totalWeight();
+    summary.mStatistics = mStatistics;
+    summary.mScoreRankings = mScoreRankings;
+    summary.mPreferences = mLiveMatrix;
+
+    return summary;
+}
+
+/*!
+ *  Returns @c true if the election maintains a live tally of head-to-head preferences; otherwise,
+ *  returns @c false.
+ *
+ *  @sa enableLiveTally().
+ */
+bool Election::hasLiveTally() const { return bool(mLiveMatrix); }
+
+/*!
+ *  Has the election start maintaining the head-to-head preferences between every pair of its candidates,
+ *  which are then kept up to date by appendBallot() and retractBallot().
+ *
+ *  The initial preferences are determined from the election's current ballots using up to
+ *  @a threadCount threads. Does nothing if a live tally is already enabled.
+ *
+ *  @sa hasLiveTally().
+ */
+void Election::enableLiveTally(int threadCount)
+{
+    if(!mLiveMatrix)
+        mLiveMatrix = std::make_shared<PreferenceMatrix>(this, threadCount);
+}
+
+/*!
+ *  Adds a ballot from @a voter with the given @a scores and @a weight to the election, updating its
+ *  statistics, score rankings and, if enabled, its live tally.
+ *
+ *  The scores are positional and correspond to the candidates of the election by ID. Candidates without a
+ *  corresponding score receive a score of @c 0, and candidates cannot be added this way.
+ *
+ *  @sa retractBallot() and enableLiveTally().
+ */
+void Election::appendBallot(const Voter& voter, std::span<const quint8> scores, int weight)
+{
+    Q_ASSERT_X(scores.size() <= size_t(candidateCount()), "Election::appendBallot", "more scores than candidates");
+    Q_ASSERT_X(weight > 0, "Election::appendBallot", "weight must be positive");
+
+    // Make room in the table if needed, which occurs less often the larger the election grows
+    qsizetype ballotIdx = ballotCount();
+    bool sparse = mScoreLayout == Sparse;
+    if(!sparse && ballotIdx == mScoreStride)
+        growScores(std::max(MIN_LIVE_STRIDE, mScoreStride * 2));
+
+    QVarLengthArray<quint8, 64> ballot(candidateCount());
+    qsizetype sparseStart = mSparseScores.size();
+
+    for(qsizetype id = 0; id < candidateCount(); id++)
+    {
+        quint8 score = size_t(id) < scores.size() ? std::min(scores[id], quint8(ScoreStatistics::MAX_SCORE)) : quint8(0);
+        ballot[id] = score;
+        if(!sparse)
+            storeScore(id, ballotIdx, score);
+        else if(score != 0)
+            mSparseScores.append(SparseScore{.candidateId = int(id), .score = score});
+        mStatistics[id].scoreCounts[score] += weight;
+    }
+
+    if(sparse)
+    {
+        mSparseOffsets.append(sparseStart);
+        mSparseCounts.append(mSparseScores.size() - sparseStart);
+    }
+
+    mVoters.append(voter);
+
+    // Weights are only stored individually once one of them isn't 1
+    if(weight != 1 && mWeights.isEmpty())
+        mWeights.resize(ballotIdx, 1);
+    if(!mWeights.isEmpty())
+        mWeights.append(weight);
+    mTotalWeight += weight;
+
+    if(mLiveMatrix)
+    {
+        if(sparse)
+            liveMatrix().addSparseBallot(sparseScores(ballotIdx), weight);
+        else
+            liveMatrix().addBallot(std::span<const quint8>(ballot.constData(), ballot.size()), weight);
+    }
+
+    rankScores();
+}
+
+/*!
+ *  Removes the ballot at index @a index from the election, updating its statistics, score rankings and,
+ *  if enabled, its live tally.
+ *
+ *  To avoid shifting every following ballot, the last ballot of the election takes the place of the
+ *  removed one, so the index of the last ballot changes.
+ *
+ *  @sa appendBallot() and enableLiveTally().
+ */
+void Election::retractBallot(qsizetype index)
+{
+    Q_ASSERT_X(size_t(index) < size_t(ballotCount()), "Election::retractBallot", "index out of range");
+
+    qsizetype lastIdx = ballotCount() - 1;
+    int weight = ballotWeight(index);
+    bool sparse = mScoreLayout == Sparse;
+    QVarLengthArray<quint8, 64> ballot(candidateCount());
+    QVarLengthArray<SparseScore, 16> sparseBallot;
+
+    if(sparse)
+    {
+        // Only the nonzero scores are visited, with the rest of the ballot's weight coming off the zero counts
+        std::span<const SparseScore> entries = sparseScores(index);
+        sparseBallot.append(entries.data(), entries.size());
+
+        for(ScoreStatistics& stats : mStatistics)
+            stats.scoreCounts[0] -= weight;
+        for(const SparseScore& entry : sparseBallot)
+        {
+            mStatistics[entry.candidateId].scoreCounts[0] += weight;
+            mStatistics[entry.candidateId].scoreCounts[entry.score] -= weight;
+        }
+
+        // The last ballot's entries are simply referred to from its new index, leaving the removed ones behind
+        mSparseGarbage += mSparseCounts.at(index);
+        mSparseOffsets[index] = mSparseOffsets.at(lastIdx);
+        mSparseCounts[index] = mSparseCounts.at(lastIdx);
+        mSparseOffsets.removeLast();
+        mSparseCounts.removeLast();
+    }
+    else
+    {
+        for(qsizetype id = 0; id < candidateCount(); id++)
+        {
+            ballot[id] = storedScore(id, index);
+            mStatistics[id].scoreCounts[ballot[id]] -= weight;
+            storeScore(id, index, storedScore(id, lastIdx));
+
+            // The vacated slot is cleared since bit planes are compared a whole word at a time
+            storeScore(id, lastIdx, 0);
+        }
+    }
+
+    mVoters.swapItemsAt(index, lastIdx);
+    mVoters.removeLast();
+    if(!mWeights.isEmpty())
+    {
+        mWeights.swapItemsAt(index, lastIdx);
+        mWeights.removeLast();
+    }
+    mTotalWeight -= weight;
+
+    // Garbage is only cleared out once it makes up most of the entries, so that each retraction stays cheap on average
+    if(sparse && mSparseGarbage > mSparseScores.size() / 2)
+        compactSparseScores();
+
+    if(mLiveMatrix)
+    {
+        if(sparse)
+            liveMatrix().addSparseBallot(std::span<const SparseScore>(sparseBallot.constData(), sparseBallot.size()), -weight);
+        else
+            liveMatrix().addBallot(std::span<const quint8>(ballot.constData(), ballot.size()), -weight);
+    }
+
+    rankScores();
+}
+
 //===============================================================================================================
 // Election::Voter
 //===============================================================================================================
@@ -107,6 +678,88 @@ const QList<Rank>& Election::scoreRankings() const { return mScoreRankings; }
  *  The anonymized name of the voter. Primarily used for logging.
  */
 
+//===============================================================================================================
+// Election::SparseScore
+//===============================================================================================================
+
+/*!
+ *  @struct Election::SparseScore star/election.h
+ *
+ *  @brief The Election::SparseScore struct holds one nonzero score of a ballot in an election that stores its
+ *  scores sparsely.
+ *
+ *  @sa Election::sparseScores().
+ */
+
+/*!
+ *  @var int Election::SparseScore::candidateId
+ *
+ *  The ID of the candidate that was scored.
+ */
+
+/*!
+ *  @var quint8 Election::SparseScore::score
+ *
+ *  The score given to the candidate, which is never @c 0.
+ */
+
+//===============================================================================================================
+// Election::ScoreStatistics
+//===============================================================================================================
+
+/*!
+ *  @struct Election::ScoreStatistics star/election.h
+ *
+ *  @brief The Election::ScoreStatistics struct summarizes the scores given to a single candidate in an
+ *  election.
+ *
+ *  @sa Election::statistics().
+ */
+
+/*!
+ *  @var int Election::ScoreStatistics::MAX_SCORE
+ *
+ *  The highest score that can be given to a candidate.
+ */
+
+/*!
+ *  @var std::array<int, Election::ScoreStatistics::MAX_SCORE + 1> Election::ScoreStatistics::scoreCounts
+ *
+ *  The number of ballots that gave the candidate each score, indexed by score. Each ballot is counted
+ *  according to its weight.
+ */
+
+/*!
+ *  Returns the number of ballots that gave the candidate a score of @a score.
+ */
+int Election::ScoreStatistics::count(int score) const { return scoreCounts.at(score); }
+
+/*!
+ *  Returns the number of ballots counted, according to their weights.
+ */
+int Election::ScoreStatistics::ballotCount() const { return std::accumulate(scoreCounts.cbegin(), scoreCounts.cend(), 0); }
+
+/*!
+ *  Returns the sum of all scores given to the candidate.
+ */
+int Election::ScoreStatistics::totalScore() const
+{
+    int total = 0;
+    for(int s = 1; s <= MAX_SCORE; s++)
+        total += s * scoreCounts[s];
+
+    return total;
+}
+
+/*!
+ *  Returns the mean score given to the candidate, or @c 0 if there are no ballots.
+ */
+double Election::ScoreStatistics::averageScore() const
+{
+    int ballots = ballotCount();
+    return ballots > 0 ? static_cast<double>(totalScore()) / ballots : 0.0;
+}
+
 //===============================================================================================================
 // Election::Vote
 //===============================================================================================================
@@ -142,26 +795,58 @@ const QList<Rank>& Election::scoreRankings() const { return mScoreRankings; }
  *
  *  A Ballot is composed of a voter and their votes.
  *
- *  Ballots are not designed to be created directly, but rather through Election::Builder::wBallot().
+ *  Ballots are not designed to be created directly, but rather through Election::Builder::wBallot(), and
+ *  are accessed via Election::ballots() or Election::ballotAt(). A ballot does not hold its votes itself,
+ *  but is only a reference to a position within the election it belongs to, which has the following
+ *  consequences:
+ *
+ *  - A ballot must not be used once its election is destroyed, moved from, or assigned to.
+ *  - A ballot refers to an index rather than to a particular voter. Retracting any ballot via
+ *    Election::retractBallot() moves the last ballot into the retracted one's place, after which a ballot
+ *    for either index refers to a different voter or is out of range altogether.
+ *  - The reference returned by voter() is invalidated by any ballot being appended or retracted.
+ *
+ *  Anything that must outlive these changes should therefore be copied out of the ballot right away.
  *
  *  @sa Election::Vote and Election::Voter.
  */
 
 //-Constructor--------------------------------------------------------------------------------------------------------
 //Private:
-Election::Ballot::Ballot() {}
+Election::Ballot::Ballot(const Election* election, qsizetype index) :
+    mElection(election),
+    mIndex(index)
+{}
 
 //-Instance Functions-------------------------------------------------------------------------------------------------
 //Public:
 /*!
  *  Returns the voter that the ballot is attributed it.
  */
-const Election::Voter& Election::Ballot::voter() const { return mVoter; }
+const Election::Voter& Election::Ballot::voter() const { return mElection->mVoters.at(mIndex); }
+
+/*!
+ *  Returns the weight of the ballot, which is the number of voters that cast it.
+ *
+ *  @sa Election::ballotWeight().
+ */
+int Election::Ballot::weight() const { return mElection->ballotWeight(mIndex); }
 
 /*!
  *  Returns the score given to @a candidate on the ballot.
  */
-int Election::Ballot::score(const QString& candidate) const { return mVotes.value(candidate, 0); }
+int Election::Ballot::score(const QString& candidate) const
+{
+    int id = mElection->candidateId(candidate);
+    return id != -1 ? score(id) : 0;
+}
+
+/*!
+ *  @overload
+ *
+ *  Returns the score given to the candidate with ID @a candidateId on the ballot.
+ */
+int Election::Ballot::score(int candidateId) const { return mElection->score(candidateId, mIndex); }
 
 /*!
  *  Returns the candidate preferred between @a candidateA and @a candidateB on the ballot, or a
@@ -193,6 +878,9 @@ QString Election::Ballot::preference(const QString& candidateA, const QString& c
  *  missing votes for a candidate that is present in other ballots, that ballots vote for that candidate
  *  is considered to be @c 0.
  *
+ *  Every way of adding a ballot optionally accepts a weight, which is the number of voters that cast it.
+ *  Alternatively, identical ballots can be left for the builder to combine via wCollapseDuplicates().
+ *
  *  @sa Election.
  */
 
@@ -203,35 +891,547 @@ QString Election::Ballot::preference(const QString& candidateA, const QString& c
  *
  *  @sa build().
  */
-Election::Builder::Builder(const QString& name)
+Election::Builder::Builder(const QString& name) :
+    mBallotCount(0),
+    mTotalWeight(0),
+    mScoreLayout(Bytes),
+    mReservedBallots(0),
+    mCollapseDuplicates(false)
 {
     mConstruct.mName = name;
 }
 
 //-Instance Functions-------------------------------------------------------------------------------------------------
+//Private:
+int Election::Builder::registerCandidate(const QString& candidate)
+{
+    auto idItr = mArrivalIds.constFind(candidate);
+    if(idItr != mArrivalIds.cend())
+        return *idItr;
+
+    // New candidates have a score of 0 on all previous ballots
+    int id = mArrivalCandidates.size();
+    mArrivalIds.insert(candidate, id);
+    mArrivalCandidates.append(candidate);
+    if(mScoreLayout != Sparse)
+    {
+        mArrivalScores.append(QList<quint8>(mBallotCount, 0));
+        mArrivalScores.last().reserve(mReservedBallots);
+    }
+
+    ScoreStatistics stats;
+    stats.scoreCounts[0] = mTotalWeight;
+    mArrivalStatistics.append(stats);
+
+    return id;
+}
+
+void Election::Builder::recordVotes(const QList<Vote>& votes, int weight)
+{
+    // Register any new candidates first so that they also get a slot for this ballot
+    for(const Vote& vote : votes)
+        registerCandidate(vote.candidate);
+
+    if(mScoreLayout == Sparse)
+    {
+        // Only nonzero scores are staged, and a repeated candidate takes its last score like below
+        qsizetype start = mArrivalEntries.size();
+        mArrivalOffsets.append(start);
+        mBallotCount++;
+
+        for(const Vote& vote : votes)
+        {
+            int id = mArrivalIds.value(vote.candidate);
+            quint8 score = std::max(0, std::min(vote.score, ScoreStatistics::MAX_SCORE));
+            auto entry = std::find_if(mArrivalEntries.begin() + start, mArrivalEntries.end(), [id](const SparseScore& e){
+                return e.candidateId == id;
+            });
+
+            if(entry != mArrivalEntries.end())
+            {
+                mArrivalStatistics[id].scoreCounts[entry->score] -= weight;
+                mArrivalEntries.erase(entry);
+            }
+            if(score != 0)
+            {
+                mArrivalEntries.append(SparseScore{.candidateId = id, .score = score});
+                mArrivalStatistics[id].scoreCounts[score] += weight;
+            }
+        }
+
+        std::sort(mArrivalEntries.begin() + start, mArrivalEntries.end(), [](const SparseScore& a, const SparseScore& b){
+            return a.candidateId < b.candidateId;
+        });
+
+        recordWeight(weight);
+        return;
+    }
+
+    // Extend each candidate's scores for the new ballot, which defaults to 0
+    qsizetype ballotIdx = mBallotCount++;
+    for(QList<quint8>& candidateScores : mArrivalScores)
+        candidateScores.append(0);
+    for(ScoreStatistics& stats : mArrivalStatistics)
+        stats.scoreCounts[0] += weight;
+
+    // Record scores
+    for(const Vote& vote : votes)
+    {
+        int id = mArrivalIds.value(vote.candidate);
+        quint8& score = mArrivalScores[id][ballotIdx];
+        ScoreStatistics& stats = mArrivalStatistics[id];
+
+        stats.scoreCounts[score] -= weight;
+        score = std::max(0, std::min(vote.score, ScoreStatistics::MAX_SCORE));
+        stats.scoreCounts[score] += weight;
+    }
+
+    recordWeight(weight);
+}
+
+void Election::Builder::recordScores(std::span<const quint8> scores, int weight)
+{
+    Q_ASSERT_X(scores.size() <= size_t(mArrivalCandidates.size()), "Election::Builder::wBallot", "more scores than candidates");
+
+    if(mScoreLayout == Sparse)
+    {
+        // Omitted scores are 0, so only the given ones need to be looked at
+        mArrivalOffsets.append(mArrivalEntries.size());
+        for(qsizetype id = 0; id < qsizetype(scores.size()); id++)
+        {
+            quint8 score = std::min(scores[id], quint8(ScoreStatistics::MAX_SCORE));
+            if(score != 0)
+            {
+                mArrivalEntries.append(SparseScore{.candidateId = int(id), .score = score});
+                mArrivalStatistics[id].scoreCounts[score] += weight;
+            }
+        }
+    }
+    else
+    {
+        for(qsizetype id = 0; id < mArrivalScores.size(); id++)
+        {
+            quint8 score = size_t(id) < scores.size() ? std::min(scores[id], quint8(ScoreStatistics::MAX_SCORE)) : quint8(0);
+            mArrivalScores[id].append(score);
+            mArrivalStatistics[id].scoreCounts[score] += weight;
+        }
+    }
+
+    mBallotCount++;
+    recordWeight(weight);
+}
+
+void Election::Builder::recordWeight(int weight)
+{
+    // Expects the ballot to already be counted
+    Q_ASSERT_X(weight > 0, "Election::Builder::wBallot", "weight must be positive");
+
+    // Weights are only tracked individually once one of them isn't 1
+    if(weight != 1 && mArrivalWeights.isEmpty())
+        mArrivalWeights.resize(mBallotCount - 1, 1);
+    if(!mArrivalWeights.isEmpty())
+        mArrivalWeights.append(weight);
+
+    mTotalWeight += weight;
+}
+
+qsizetype Election::Builder::arrivalEntriesEnd(qsizetype ballot) const
+{
+    return ballot + 1 < mBallotCount ? mArrivalOffsets.at(ballot + 1) : mArrivalEntries.size();
+}
+
+void Election::Builder::settleZeroCounts()
+{
+    /* The sparse layout never tracks scores of 0 as ballots are added, since that would involve every
+     * candidate, so they're instead determined from the total weight once needed.
+     */
+    for(ScoreStatistics& stats : mArrivalStatistics)
+        stats.scoreCounts[0] = int(mTotalWeight - std::accumulate(stats.scoreCounts.cbegin() + 1, stats.scoreCounts.cend(), 0));
+}
+
+void Election::Builder::restage(ScoreLayout layout)
+{
+    // Convert any ballots that were already staged when switching to or from the sparse layout
+    bool sparse = layout == Sparse;
+    if(sparse == (mScoreLayout == Sparse))
+        return;
+
+    if(sparse)
+    {
+        mArrivalOffsets.reserve(std::max(mBallotCount, mReservedBallots));
+        for(qsizetype b = 0; b < mBallotCount; b++)
+        {
+            mArrivalOffsets.append(mArrivalEntries.size());
+            for(qsizetype id = 0; id < mArrivalScores.size(); id++)
+                if(quint8 score = mArrivalScores.at(id).at(b))
+                    mArrivalEntries.append(SparseScore{.candidateId = int(id), .score = score});
+        }
+
+        mArrivalScores.clear();
+    }
+    else
+    {
+        settleZeroCounts();
+        mArrivalScores.resize(mArrivalCandidates.size());
+        for(QList<quint8>& candidateScores : mArrivalScores)
+        {
+            candidateScores.reserve(std::max(mBallotCount, mReservedBallots));
+            candidateScores.resize(mBallotCount, 0);
+        }
+
+        for(qsizetype b = 0; b < mBallotCount; b++)
+            for(qsizetype e = mArrivalOffsets.at(b); e < arrivalEntriesEnd(b); e++)
+                mArrivalScores[mArrivalEntries.at(e).candidateId][b] = mArrivalEntries.at(e).score;
+
+        mArrivalEntries.clear();
+        mArrivalOffsets.clear();
+    }
+}
+
+void Election::Builder::prepareVoter()
+{
+    // Voter storage is only reserved once a voter is actually given, since they may instead be shared via wVoters()
+    if(mConstruct.mVoters.capacity() < mReservedBallots)
+        mConstruct.mVoters.reserve(mReservedBallots);
+
+    fitVoters(mBallotCount);
+}
+
+void Election::Builder::fitVoters(qsizetype count)
+{
+    /* Ballots added without a voter are given a default one once something needs to follow them. The size
+     * is checked first since resizing a list always detaches it, even if shared voters already fit.
+     */
+    if(mConstruct.mVoters.size() != count)
+        mConstruct.mVoters.resize(count);
+}
+
+void Election::Builder::collapseDuplicates()
+{
+    qsizetype candidateCount = mArrivalScores.size();
+    bool sparse = mScoreLayout == Sparse;
+    fitVoters(mBallotCount);
+
+    /* Find the first ballot with each distinct set of scores, which are gathered across the staged
+     * per-candidate lists into one key per ballot, or taken from the staged entries of sparse ballots.
+     * The first ballot then stands in for all of its duplicates with their combined weight.
+     */
+    QHash<QByteArray, qsizetype> patternIdx;
+    QList<qsizetype> firstBallots;
+    QList<int> weights;
+    QByteArray pattern(candidateCount, 0);
+
+    for(qsizetype b = 0; b < mBallotCount; b++)
+    {
+        if(sparse)
+        {
+            // Entries are already ordered by candidate, so equal ballots have equal keys
+            pattern.resize(0);
+            for(qsizetype e = mArrivalOffsets.at(b); e < arrivalEntriesEnd(b); e++)
+            {
+                const SparseScore& entry = mArrivalEntries.at(e);
+                pattern.append(reinterpret_cast<const char*>(&entry.candidateId), sizeof(entry.candidateId));
+                pattern.append(char(entry.score));
+            }
+        }
+        else
+        {
+            for(qsizetype id = 0; id < candidateCount; id++)
+                pattern[id] = char(mArrivalScores.at(id).at(b));
+        }
+
+        int weight = mArrivalWeights.isEmpty() ? 1 : mArrivalWeights.at(b);
+        auto itr = patternIdx.constFind(pattern);
+        if(itr != patternIdx.cend())
+            weights[*itr] += weight;
+        else
+        {
+            patternIdx.insert(pattern, firstBallots.size());
+            firstBallots.append(b);
+            weights.append(weight);
+        }
+    }
+
+    qsizetype patternCount = firstBallots.size();
+    if(patternCount == mBallotCount)
+        return;
+
+    // Compact in place, which is safe since each kept ballot only ever moves towards the front
+    if(sparse)
+    {
+        qsizetype kept = 0;
+        for(qsizetype p = 0; p < patternCount; p++)
+        {
+            qsizetype b = firstBallots.at(p);
+            qsizetype start = mArrivalOffsets.at(b);
+            qsizetype end = arrivalEntriesEnd(b);
+
+            mArrivalOffsets[p] = kept;
+            for(qsizetype e = start; e < end; e++)
+                mArrivalEntries[kept++] = mArrivalEntries.at(e);
+        }
+        mArrivalOffsets.resize(patternCount);
+        mArrivalEntries.resize(kept);
+    }
+
+    for(QList<quint8>& candidateScores : mArrivalScores)
+    {
+        for(qsizetype p = 0; p < patternCount; p++)
+            candidateScores[p] = candidateScores.at(firstBallots.at(p));
+        candidateScores.resize(patternCount);
+    }
+
+    QList<Voter>& voters = mConstruct.mVoters;
+    for(qsizetype p = 0; p < patternCount; p++)
+        voters[p] = voters.at(firstBallots.at(p));
+    voters.resize(patternCount);
+
+    mArrivalWeights = std::move(weights);
+    mBallotCount = patternCount;
+}
+
 //Public:
 /*!
- *  Creates a ballot containing the @a votes from @a voter and adds them to the builder.
+ *  Prepares the builder to hold at least @a ballots ballots for @a candidates candidates, so that
+ *  adding them does not require repeatedly growing its storage.
+ *
+ *  This is only a hint; more ballots or candidates than reserved can still be added.
  *
  *  Returns a reference to the builder.
  */
-Election::Builder& Election::Builder::wBallot(const Voter& voter, const QList<Vote>& votes)
+Election::Builder& Election::Builder::reserve(qsizetype ballots, qsizetype candidates)
 {
-    // Create ballot and add scores to construct total tracker
-    Election::Ballot ballot;
-    ballot.mVoter = voter;
+    mReservedBallots = std::max(mReservedBallots, ballots);
 
-    for(const Vote& vote : votes)
+    mArrivalIds.reserve(candidates);
+    mArrivalCandidates.reserve(candidates);
+    mArrivalScores.reserve(candidates);
+    mArrivalStatistics.reserve(candidates);
+
+    for(QList<quint8>& candidateScores : mArrivalScores)
+        candidateScores.reserve(ballots);
+    if(mScoreLayout == Sparse)
+        mArrivalOffsets.reserve(ballots);
+
+    return *this;
+}
+
+/*!
+ *  Adds @a candidates to the work-in-progress election, in order, skipping any that are already present.
+ *
+ *  Candidates are otherwise added automatically as they first appear in a ballot, but registering them
+ *  ahead of time allows ballots to be added positionally with wBallot(const Voter&, std::span<const quint8>).
+ *
+ *  Returns a reference to the builder.
+ */
+Election::Builder& Election::Builder::wCandidates(const QStringList& candidates)
+{
+    for(const QString& candidate : candidates)
+        registerCandidate(candidate);
+
+    return *this;
+}
+
+/*!
+ *  Creates a ballot containing the @a votes from @a voter and adds them to the builder, with a weight of
+ *  @a weight, which must be positive.
+ *
+ *  Returns a reference to the builder.
+ */
+Election::Builder& Election::Builder::wBallot(const Voter& voter, const QList<Vote>& votes, int weight)
+{
+    prepareVoter();
+    recordVotes(votes, weight);
+    mConstruct.mVoters.append(voter);
+    return *this;
+}
+
+/*!
+ *  @overload
+ *
+ *  Same as wBallot(const Voter&, const QList<Vote>&, int), but moves @a voter into the builder.
+ */
+Election::Builder& Election::Builder::wBallot(Voter&& voter, const QList<Vote>& votes, int weight)
+{
+    prepareVoter();
+    recordVotes(votes, weight);
+    mConstruct.mVoters.append(std::move(voter));
+    return *this;
+}
+
+/*!
+ *  @overload
+ *
+ *  Creates a ballot from @a voter with the given @a scores and @a weight and adds it to the builder.
+ *
+ *  The scores are positional and correspond to the candidates of the work-in-progress election in the order
+ *  they were added, whether via wCandidates() or previous ballots. Candidates without a corresponding score
+ *  receive a score of @c 0.
+ *
+ *  Returns a reference to the builder.
+ */
+Election::Builder& Election::Builder::wBallot(const Voter& voter, std::span<const quint8> scores, int weight)
+{
+    prepareVoter();
+    recordScores(scores, weight);
+    mConstruct.mVoters.append(voter);
+    return *this;
+}
+
+/*!
+ *  @overload
+ *
+ *  Same as wBallot(const Voter&, std::span<const quint8>, int), but moves @a voter into the builder.
+ */
+Election::Builder& Election::Builder::wBallot(Voter&& voter, std::span<const quint8> scores, int weight)
+{
+    prepareVoter();
+    recordScores(scores, weight);
+    mConstruct.mVoters.append(std::move(voter));
+    return *this;
+}
+
+/*!
+ *  @overload
+ *
+ *  Creates a ballot with the given @a scores and @a weight, but without a voter, and adds it to the builder.
+ *
+ *  This is intended for when the voters of several elections are the same and are provided all at once
+ *  with wVoters(), so that they can be shared instead of being duplicated for each election. A ballot
+ *  whose voter is never provided is given a default-constructed Voter.
+ *
+ *  Returns a reference to the builder.
+ */
+Election::Builder& Election::Builder::wBallot(std::span<const quint8> scores, int weight)
+{
+    recordScores(scores, weight);
+    return *this;
+}
+
+/*!
+ *  Adds a ballot for each of @a voters at once, taking their scores from @a scores, which must be a
+ *  candidate-major table in which the scores for each candidate in @a candidates are contiguous and
+ *  ordered by voter. That is, the score given by voter @c v to candidate @c c is at
+ *  <tt>c * voters.size() + v</tt>.
+ *
+ *  Candidates not already present are added in the order they appear in @a candidates. Any existing
+ *  candidates that are not part of @a candidates receive a score of @c 0 on the new ballots.
+ *
+ *  If @a weights is not empty, it must hold the weight of each ballot, ordered by voter; otherwise, every
+ *  ballot has a weight of @c 1.
+ *
+ *  This is the most efficient way to add a large number of ballots whose scores are already available
+ *  in bulk.
+ *
+ *  Returns a reference to the builder.
+ */
+Election::Builder& Election::Builder::wBallots(const QList<Voter>& voters, const QStringList& candidates, std::span<const quint8> scores,
+                                                std::span<const int> weights)
+{
+    qsizetype ballotCount = voters.size();
+    Q_ASSERT_X(scores.size() == size_t(candidates.size() * ballotCount), "Election::Builder::wBallots", "score table size mismatch");
+    Q_ASSERT_X(weights.empty() || weights.size() == size_t(ballotCount), "Election::Builder::wBallots", "weight count mismatch");
+
+    // Determine the weight of the new ballots as a whole, tracking them individually if needed
+    qsizetype addedWeight = ballotCount;
+    if(!weights.empty())
     {
-        const QString& candidate = vote.candidate;
+        addedWeight = 0;
+        for(int w : weights)
+        {
+            Q_ASSERT_X(w > 0, "Election::Builder::wBallots", "weight must be positive");
+            addedWeight += w;
+        }
+    }
+
+    if(addedWeight != ballotCount && mArrivalWeights.isEmpty())
+        mArrivalWeights.resize(mBallotCount, 1);
+    if(!mArrivalWeights.isEmpty())
+    {
+        if(weights.empty())
+            mArrivalWeights.resize(mBallotCount + ballotCount, 1);
+        else
+            mArrivalWeights.append(QList<int>(weights.begin(), weights.end()));
+    }
+
+    // Register candidates and extend all of them for the new ballots, which defaults to 0
+    for(const QString& candidate : candidates)
+        registerCandidate(candidate);
+
+    qsizetype firstBallot = mBallotCount;
+    mBallotCount += ballotCount;
+    for(QList<quint8>& candidateScores : mArrivalScores)
+        candidateScores.resize(firstBallot + ballotCount);
+    for(ScoreStatistics& stats : mArrivalStatistics)
+        stats.scoreCounts[0] += addedWeight;
+    mTotalWeight += addedWeight;
+
+    if(mScoreLayout == Sparse)
+    {
+        // Regather the table ballot by ballot, visiting candidates in ID order so that each ballot's entries come out ordered
+        QList<std::pair<int, qsizetype>> columns;
+        columns.reserve(candidates.size());
+        for(qsizetype i = 0; i < candidates.size(); i++)
+            columns.append({mArrivalIds.value(candidates.at(i)), i});
+        std::sort(columns.begin(), columns.end());
 
-        int score = std::max(0, std::min(vote.score, 5));
-        ballot.mVotes[candidate] = score;
-        mConstruct.mTotals[candidate] += score;
+        mArrivalOffsets.reserve(mBallotCount);
+        for(qsizetype v = 0; v < ballotCount; v++)
+        {
+            int weight = weights.empty() ? 1 : weights[v];
+            mArrivalOffsets.append(mArrivalEntries.size());
+            for(const auto& [id, i] : std::as_const(columns))
+            {
+                quint8 s = std::min(scores[i * ballotCount + v], quint8(ScoreStatistics::MAX_SCORE));
+                if(s != 0)
+                {
+                    mArrivalEntries.append(SparseScore{.candidateId = id, .score = s});
+                    mArrivalStatistics[id].scoreCounts[s] += weight;
+                }
+            }
+        }
+    }
+    else
+    {
+        // Copy each candidate's block of scores
+        for(qsizetype i = 0; i < candidates.size(); i++)
+        {
+            int id = mArrivalIds.value(candidates.at(i));
+            std::span<const quint8> block = scores.subspan(i * ballotCount, ballotCount);
+            QList<quint8>& candidateScores = mArrivalScores[id];
+            std::array<int, ScoreStatistics::MAX_SCORE + 1>& counts = mArrivalStatistics[id].scoreCounts;
+
+            auto dest = candidateScores.begin() + firstBallot;
+            if(weights.empty())
+            {
+                for(quint8 s : block)
+                {
+                    s = std::min(s, quint8(ScoreStatistics::MAX_SCORE));
+                    *dest++ = s;
+                    counts[s]++;
+                }
+            }
+            else
+            {
+                for(qsizetype v = 0; v < ballotCount; v++)
+                {
+                    quint8 s = std::min(block[v], quint8(ScoreStatistics::MAX_SCORE));
+                    *dest++ = s;
+                    counts[s] += weights[v];
+                }
+            }
+            counts[0] -= addedWeight;
+        }
     }
 
-    // Add ballot to construct
-    mConstruct.mBallots.append(ballot);
+    // Add voters to construct, sharing the list if possible
+    if(firstBallot == 0)
+        mConstruct.mVoters = voters;
+    else
+    {
+        fitVoters(firstBallot);
+        mConstruct.mVoters.append(voters);
+    }
 
     return *this;
 }
@@ -243,6 +1443,20 @@ Election::Builder& Election::Builder::wBallot(const Voter& voter, const QList<Vo
  */
 Election::Builder& Election::Builder::wName(const QString& name) { mConstruct.mName = name; return *this; }
 
+/*!
+ *  Sets the voters of the ballots added to the builder to @a voters, in the order the ballots were added,
+ *  replacing any they already had.
+ *
+ *  The list is shared rather than copied, so any number of elections whose ballots come from the same
+ *  voters can refer to a single list. Voters beyond the number of ballots are ignored, and ballots beyond
+ *  the number of voters are given a default-constructed Voter.
+ *
+ *  Returns a reference to the builder.
+ *
+ *  @sa wBallot(std::span<const quint8>).
+ */
+Election::Builder& Election::Builder::wVoters(const QList<Voter>& voters) { mConstruct.mVoters = voters; return *this; }
+
 /*!
  *  Sets the seat count of the work-in-progress election to @a count.
  *
@@ -250,6 +1464,40 @@ Election::Builder& Election::Builder::wName(const QString& name) { mConstruct.mN
  */
 Election::Builder& Election::Builder::wSeatCount(int count) { mConstruct.mSeats = count; return *this; }
 
+/*!
+ *  Sets whether or not ballots with identical scores are combined into a single ballot when the election
+ *  is built, according to @a collapse. Disabled by default.
+ *
+ *  Each set of duplicates is replaced by the first of them, with a weight equal to their combined weight,
+ *  so only the voter of that first ballot is kept. Since every head-to-head tally then only needs to
+ *  examine each distinct set of scores once, this greatly reduces the cost of calculating the results of
+ *  elections with few candidates and many voters, for which duplicates are common.
+ *
+ *  Returns a reference to the builder.
+ *
+ *  @sa Election::totalWeight().
+ */
+Election::Builder& Election::Builder::wCollapseDuplicates(bool collapse) { mCollapseDuplicates = collapse; return *this; }
+
+/*!
+ *  Sets the layout in which the scores of the work-in-progress election are stored to @a layout. The default
+ *  is Election::Bytes.
+ *
+ *  Ballots are also staged sparsely while the layout is Election::Sparse, so that the builder itself doesn't
+ *  set aside a score for every candidate on every ballot either. The layout should therefore be chosen before
+ *  any ballots are added, though ones that were already added are converted if need be.
+ *
+ *  Returns a reference to the builder.
+ *
+ *  @sa Election::scoreLayout().
+ */
+Election::Builder& Election::Builder::wScoreLayout(ScoreLayout layout)
+{
+    restage(layout);
+    mScoreLayout = layout;
+    return *this;
+}
+
 /*!
  *  Resets the work-in-progress election to a default-constructed one.
  */
@@ -258,18 +1506,142 @@ void Election::Builder::reset()
     QString name = mConstruct.mName;
     mConstruct = Election();
     mConstruct.mName = name;
+
+    mArrivalIds.clear();
+    mArrivalCandidates.clear();
+    mArrivalScores.clear();
+    mArrivalEntries.clear();
+    mArrivalOffsets.clear();
+    mArrivalStatistics.clear();
+    mArrivalWeights.clear();
+    mBallotCount = 0;
+    mTotalWeight = 0;
+    mReservedBallots = 0;
 }
 
 /*!
  *  Completes the work-in-progress election and returns it.
+ *
+ *  The election is moved out of the builder rather than copied, so afterwards the builder is left as if
+ *  reset() had been called.
  */
 Election Election::Builder::build()
 {
+    if(mCollapseDuplicates)
+        collapseDuplicates();
+    if(mScoreLayout == Sparse)
+        settleZeroCounts();
+
+    // Assign final IDs according to name order
+    qsizetype candidateCount = mArrivalCandidates.size();
+    qsizetype ballotCount = mBallotCount;
+    fitVoters(ballotCount);
+
+    QList<int> order(candidateCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b){
+        return mArrivalCandidates.at(a) < mArrivalCandidates.at(b);
+    });
+
+    /* Lay out scores contiguously, along with their already tallied statistics
+     *
+     * The table is only reserved up front and then filled by appending, while each candidate's staged
+     * scores are released as soon as they've been copied. That way the untouched portion of the table
+     * isn't committed to memory before it's written, and the election doesn't briefly exist twice.
+     */
+    mConstruct.mCandidates.clear();
+    mConstruct.mCandidateIds.clear();
+    mConstruct.mScoreLayout = mScoreLayout;
+    mConstruct.mScores.clear();
+    mConstruct.mScorePlanes.clear();
+    mConstruct.mSparseScores.clear();
+    mConstruct.mSparseOffsets.clear();
+    mConstruct.mSparseCounts.clear();
+    mConstruct.mSparseGarbage = 0;
+    mConstruct.mStatistics.resize(candidateCount);
+
+    bool planar = mScoreLayout == BitPlanes;
+    bool sparse = mScoreLayout == Sparse;
+    qsizetype groupCount = (ballotCount + PLANE_WIDTH - 1) / PLANE_WIDTH;
+    if(planar)
+    {
+        // The planes have to start out cleared since they're filled a bit at a time
+        mConstruct.mScoreStride = groupCount * PLANE_WIDTH;
+        mConstruct.mScorePlanes.resize(candidateCount * groupCount * PLANE_COUNT, 0);
+    }
+    else if(sparse)
+        mConstruct.mScoreStride = 0;
+    else
+    {
+        mConstruct.mScoreStride = ballotCount;
+        mConstruct.mScores.reserve(candidateCount * ballotCount);
+    }
+
+    for(int id = 0; id < candidateCount; id++)
+    {
+        int arrivalId = order.at(id);
+        const QString& candidate = mArrivalCandidates.at(arrivalId);
+        const ScoreStatistics& stats = mArrivalStatistics.at(arrivalId);
+
+        if(planar)
+        {
+            const QList<quint8>& arrivalScores = mArrivalScores.at(arrivalId);
+            quint64* planes = mConstruct.mScorePlanes.data() + id * groupCount * PLANE_COUNT;
+            for(qsizetype b = 0; b < ballotCount; b++)
+            {
+                quint64* group = planes + b / PLANE_WIDTH * PLANE_COUNT;
+                int shift = b % PLANE_WIDTH;
+                for(int p = 0; p < PLANE_COUNT; p++)
+                    group[p] |= quint64((arrivalScores.at(b) >> p) & 1) << shift;
+            }
+        }
+        else if(!sparse)
+            mConstruct.mScores.append(mArrivalScores.at(arrivalId));
+        if(!sparse)
+            mArrivalScores[arrivalId] = QList<quint8>();
+
+        mConstruct.mCandidates.append(candidate);
+        mConstruct.mCandidateIds.insert(candidate, id);
+        mConstruct.mStatistics[id] = stats;
+    }
+
+    if(sparse)
+    {
+        // Sparse entries are kept as staged, just translated to the final IDs and reordered accordingly
+        QList<int> finalIds(candidateCount);
+        for(int id = 0; id < candidateCount; id++)
+            finalIds[order.at(id)] = id;
+
+        for(SparseScore& entry : mArrivalEntries)
+            entry.candidateId = finalIds.at(entry.candidateId);
+
+        mConstruct.mSparseCounts.reserve(ballotCount);
+        for(qsizetype b = 0; b < ballotCount; b++)
+        {
+            qsizetype start = mArrivalOffsets.at(b);
+            qsizetype end = arrivalEntriesEnd(b);
+            std::sort(mArrivalEntries.begin() + start, mArrivalEntries.begin() + end, [](const SparseScore& lhs, const SparseScore& rhs){
+                return lhs.candidateId < rhs.candidateId;
+            });
+            mConstruct.mSparseCounts.append(end - start);
+        }
+
+        mConstruct.mSparseScores = std::move(mArrivalEntries);
+        mConstruct.mSparseOffsets = std::move(mArrivalOffsets);
+    }
+
+    mConstruct.mWeights = std::move(mArrivalWeights);
+    mConstruct.mTotalWeight = mTotalWeight;
+
     // Form rankings
-    mConstruct.mScoreRankings = Rank::rankSort(mConstruct.mTotals);
+    mConstruct.rankScores();
+
+    // Hand off completed construct
+    Election election = std::move(mConstruct);
+    mConstruct.mName = election.mName;
+    reset();
 
-    // Return completed construct
-    return mConstruct;
+    return election;
 }
 
 }
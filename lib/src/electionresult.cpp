@@ -13,7 +13,8 @@ namespace Star
  *
  *  @brief The ElectionResult class holds the outcome of an election.
  *
- *  Election results consist primarily of a list of seats filled according to the makeup of an Election.
+ *  Election results consist primarily of a list of seats filled according to the makeup of an Election, along
+ *  with the ElectionSummary of that election.
  *
  *  An election result for a given Election can be generated through the use of Calculator.
  *
@@ -38,6 +39,19 @@ ElectionResult::ElectionResult() :
  */
 ElectionResult::ElectionResult(const Election* election, const QList<Seat>& seats) :
     mElection(election),
+    mSummary(election ? election->summary() : ElectionSummary()),
+    mSeats(seats)
+{}
+
+/*!
+ *  Constructs a election result that corresponds to the election described by @a summary and consists of the
+ *  evaluated seats @a seats.
+ *
+ *  The result has no election.
+ */
+ElectionResult::ElectionResult(const ElectionSummary& summary, const QList<Seat>& seats) :
+    mElection(nullptr),
+    mSummary(summary),
     mSeats(seats)
 {}
 
@@ -48,7 +62,7 @@ ElectionResult::ElectionResult(const Election* election, const QList<Seat>& seat
  *
  *  @sa isComplete().
  */
-bool ElectionResult::isNull() const { return !mElection || mSeats.isEmpty(); }
+bool ElectionResult::isNull() const { return mSummary.isNull() || mSeats.isEmpty(); }
 
 /*!
  *  Returns @c true if all the seats of the election were able to be filled; otherwise, returns false.
@@ -151,13 +165,23 @@ qsizetype ElectionResult::filledSeatCount() const
  *
  *  @sa isComplete() and filledSeatCount().
  */
-qsizetype ElectionResult::unfilledSeatCount() const { return !isNull() ? mElection->seatCount() - filledSeatCount() : 0; }
+qsizetype ElectionResult::unfilledSeatCount() const { return !isNull() ? mSummary.seatCount() - filledSeatCount() : 0; }
 
 /*!
- *  Returns the election that was evaluated.
+ *  Returns the election that was evaluated, or @c nullptr if the result was determined from an election
+ *  summary alone.
+ *
+ *  @sa summary().
  */
 const Election* ElectionResult::election() const { return mElection; }
 
+/*!
+ *  Returns the summary of the election that was evaluated.
+ *
+ *  Unlike election(), this is always available for a result that is not null.
+ */
+const ElectionSummary& ElectionResult::summary() const { return mSummary; }
+
 /*!
  *  Returns true if this election result is the same as @a other; otherwise, returns false.
  *
@@ -165,7 +189,7 @@ const Election* ElectionResult::election() const { return mElection; }
  */
 bool ElectionResult::operator==(const ElectionResult& other) const
 {
-    return mElection == other.mElection && mSeats == other.mSeats;
+    return mElection == other.mElection && mSummary.name() == other.mSummary.name() && mSeats == other.mSeats;
 }
 
 /*!
@@ -0,0 +1,431 @@
+// Unit Include
+#include "star/electionsummary.h"
+
+// Standard Library Includes
+#include <numeric>
+#include <algorithm>
+
+// Qt Includes
+#include <QVarLengthArray>
+
+// Project Includes
+#include "preferencematrix.h"
+#include "ranksorter.h"
+
+namespace Star
+{
+
+//===============================================================================================================
+// ElectionSummary
+//===============================================================================================================
+
+/*!
+ *  @class ElectionSummary star/electionsummary.h
+ *
+ *  @brief The ElectionSummary class holds the aggregate figures of an election that are sufficient to
+ *  determine its outcome.
+ *
+ *  Determining the result of a STAR election never requires looking at an individual ballot, only at the
+ *  histogram of scores each candidate received and at how many ballots preferred each candidate over each
+ *  other candidate. An ElectionSummary holds just those figures, which means its size depends only on the
+ *  number of candidates, and not on the number of ballots.
+ *
+ *  A summary can be accumulated one ballot at a time with ElectionSummary::Builder, for instance while
+ *  streaming ballots from a source that is too large to be kept in memory, and then evaluated with
+ *  Calculator::calculateResult(const ElectionSummary&). Alternatively, the summary of an existing
+ *  Election can be obtained via Election::summary().
+ *
+ *  Like an Election, each candidate is assigned an ID that corresponds to their position within candidates(),
+ *  which are in name order.
+ *
+ *  @sa Election and Calculator.
+ */
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+//Public:
+/*!
+ *  Creates a null election summary.
+ *
+ *  @sa isNull() and ElectionSummary::Builder.
+ */
+ElectionSummary::ElectionSummary() :
+    mSeats(0),
+    mBallotCount(0)
+{}
+
+//-Instance Functions-------------------------------------------------------------------------------------------------
+//Public:
+/*!
+ *  Returns @c true if the summary is null, that is, if it has no candidates; otherwise, returns @c false.
+ */
+bool ElectionSummary::isNull() const { return mCandidates.isEmpty(); }
+
+/*!
+ *  Returns @c true if the summary describes a valid election; otherwise, returns false.
+ *
+ *  The requirements are the same as those of Election::isValid().
+ */
+bool ElectionSummary::isValid() const
+{
+    return candidateCount() > 1 && ballotCount() > 1 && seatCount() > 0 && seatCount() <= candidateCount();
+}
+
+/*!
+ *  Returns the name of the election.
+ */
+QString ElectionSummary::name() const { return mName; }
+
+/*!
+ *  Returns the list of candidates in the election.
+ *
+ *  The position of each candidate within the list is equivalent to their ID.
+ */
+QStringList ElectionSummary::candidates() const { return mCandidates; }
+
+/*!
+ *  Returns the number of candidates in the election.
+ */
+qsizetype ElectionSummary::candidateCount() const { return mCandidates.size(); }
+
+/*!
+ *  Returns the ID of @a candidate, or @c -1 if the candidate is not part of the election.
+ */
+int ElectionSummary::candidateId(const QString& candidate) const { return mCandidateIds.value(candidate, -1); }
+
+/*!
+ *  Returns the name of the candidate with ID @a id.
+ */
+QString ElectionSummary::candidateName(int id) const { return mCandidates.value(id); }
+
+/*!
+ *  Returns the number of ballots that were summarized.
+ */
+qsizetype ElectionSummary::ballotCount() const { return mBallotCount; }
+
+/*!
+ *  Returns the number of seats prescribed for the election.
+ */
+int ElectionSummary::seatCount() const { return mSeats; }
+
+/*!
+ *  Returns the total score for the candidate with ID @a candidateId across all ballots.
+ */
+int ElectionSummary::totalScore(int candidateId) const { return mStatistics.value(candidateId).totalScore(); }
+
+/*!
+ *  Returns the score statistics of the candidate with ID @a candidateId.
+ */
+const Election::ScoreStatistics& ElectionSummary::statistics(int candidateId) const
+{
+    Q_ASSERT_X(size_t(candidateId) < size_t(candidateCount()), "ElectionSummary::statistics", "id out of range");
+    return mStatistics.at(candidateId);
+}
+
+/*!
+ *  Returns a list of all candidates in the election ranked by total score (descending).
+ */
+const QList<Rank>& ElectionSummary::scoreRankings() const { return mScoreRankings; }
+
+/*!
+ *  Returns @c true if the summary includes the head-to-head preferences between its candidates; otherwise,
+ *  returns @c false.
+ *
+ *  Summaries created by ElectionSummary::Builder always include them, while those obtained from an Election
+ *  only do if the election has a live tally.
+ *
+ *  @sa preferences() and Election::enableLiveTally().
+ */
+bool ElectionSummary::hasPreferences() const { return bool(mPreferences); }
+
+/*!
+ *  Returns the number of ballots that scored the candidate with ID @a candidateA higher than the candidate
+ *  with ID @a candidateB, or @c 0 if the summary does not include preferences.
+ *
+ *  @sa hasPreferences().
+ */
+int ElectionSummary::preferences(int candidateA, int candidateB) const
+{
+    return mPreferences ? mPreferences->preferences(candidateA, candidateB) : 0;
+}
+
+//===============================================================================================================
+// ElectionSummary::Builder
+//===============================================================================================================
+
+/*!
+ *  @class ElectionSummary::Builder star/electionsummary.h
+ *
+ *  @brief The ElectionSummary::Builder class is used to accumulate an election summary from individual ballots.
+ *
+ *  Each ballot is folded into the summary as it is added and then discarded, so the memory used by the builder
+ *  only depends on the number of candidates.
+ *
+ *  @sa build().
+ */
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+//Public:
+/*!
+ *  Constructs an empty builder, with the name of the work-in-progress summary set to @a name.
+ */
+ElectionSummary::Builder::Builder(const QString& name)
+{
+    mConstruct.mName = name;
+}
+
+//-Instance Functions-------------------------------------------------------------------------------------------------
+//Public:
+/*!
+ *  Sets the name of the work-in-progress summary to @a name.
+ *
+ *  Returns a reference to the builder.
+ */
+ElectionSummary::Builder& ElectionSummary::Builder::wName(const QString& name) { mConstruct.mName = name; return *this; }
+
+/*!
+ *  Adds @a candidates to the work-in-progress summary, in order, skipping any that are already present.
+ *
+ *  Ballots are positional, so the order candidates are added in determines which score of each ballot they
+ *  receive. Candidates added after some ballots have already been counted are treated as having received a
+ *  score of @c 0 on all of them.
+ *
+ *  Returns a reference to the builder.
+ */
+ElectionSummary::Builder& ElectionSummary::Builder::wCandidates(const QStringList& candidates)
+{
+    qsizetype oldCount = mArrivalCandidates.size();
+    for(const QString& candidate : candidates)
+        if(!mArrivalCandidates.contains(candidate))
+            mArrivalCandidates.append(candidate);
+
+    qsizetype newCount = mArrivalCandidates.size();
+    if(newCount == oldCount)
+        return *this;
+
+    // Re-layout the preferences with room for the new candidates
+    QList<int> grown(newCount * newCount, 0);
+    for(qsizetype a = 0; a < oldCount; a++)
+        std::copy_n(mArrivalPreferences.cbegin() + a * oldCount, oldCount, grown.begin() + a * newCount);
+
+    /* A new candidate effectively received a 0 on every ballot so far, so every existing candidate
+     * is preferred over it by each ballot that gave them anything higher
+     */
+    qsizetype ballots = mConstruct.mBallotCount;
+    for(qsizetype a = 0; a < oldCount; a++)
+    {
+        int nonZero = int(ballots) - mArrivalStatistics.at(a).count(0);
+        for(qsizetype b = oldCount; b < newCount; b++)
+            grown[a * newCount + b] = nonZero;
+    }
+
+    mArrivalPreferences = std::move(grown);
+
+    Election::ScoreStatistics stats;
+    stats.scoreCounts[0] = int(ballots);
+    mArrivalStatistics.resize(newCount, stats);
+
+    return *this;
+}
+
+/*!
+ *  Sets the seat count of the work-in-progress summary to @a count.
+ *
+ *  Returns a reference to the builder.
+ */
+ElectionSummary::Builder& ElectionSummary::Builder::wSeatCount(int count) { mConstruct.mSeats = count; return *this; }
+
+/*!
+ *  Counts a ballot with the given @a scores towards the work-in-progress summary, as if it was cast by
+ *  @a weight voters.
+ *
+ *  The scores are positional and correspond to the candidates in the order they were added via wCandidates().
+ *  Candidates without a corresponding score receive a score of @c 0.
+ *
+ *  Returns a reference to the builder.
+ */
+ElectionSummary::Builder& ElectionSummary::Builder::wBallot(std::span<const quint8> scores, int weight)
+{
+    qsizetype candidateCount = mArrivalCandidates.size();
+    Q_ASSERT_X(scores.size() <= size_t(candidateCount), "ElectionSummary::Builder::wBallot", "more scores than candidates");
+    Q_ASSERT_X(weight > 0, "ElectionSummary::Builder::wBallot", "weight must be positive");
+
+    const auto scoreOf = [&](qsizetype id){
+        return size_t(id) < scores.size() ? std::min(scores[id], quint8(Election::ScoreStatistics::MAX_SCORE)) : quint8(0);
+    };
+
+    int* preferences = mArrivalPreferences.data();
+    for(qsizetype a = 0; a < candidateCount; a++)
+    {
+        quint8 scoreA = scoreOf(a);
+        mArrivalStatistics[a].scoreCounts[scoreA] += weight;
+
+        for(qsizetype b = a + 1; b < candidateCount; b++)
+        {
+            quint8 scoreB = scoreOf(b);
+            if(scoreA > scoreB)
+                preferences[a * candidateCount + b] += weight;
+            else if(scoreB > scoreA)
+                preferences[b * candidateCount + a] += weight;
+        }
+    }
+
+    mConstruct.mBallotCount += weight;
+    return *this;
+}
+
+/*!
+ *  Counts a partial tally of @a ballotCount ballots towards the work-in-progress summary, as if each of those
+ *  ballots had been added individually.
+ *
+ *  @a statistics holds the score statistics of each of @a candidates, in the same order, while @a preferences
+ *  holds the number of those ballots that preferred each candidate over each other candidate, such that
+ *  the element at <tt>a * candidates.size() + b</tt> is the count for the candidates at positions @c a
+ *  and @c b of @a candidates.
+ *
+ *  Candidates of the partial tally that are not yet part of the summary are added, and those that are not
+ *  part of the partial tally are treated as having received a score of @c 0 on all of its ballots. This makes
+ *  combining tallies associative, so that the summary of a set of ballots can be determined from the tallies
+ *  of any grouping of them, for instance one per precinct.
+ *
+ *  Returns a reference to the builder.
+ *
+ *  @sa wSummary().
+ */
+ElectionSummary::Builder& ElectionSummary::Builder::wTally(const QStringList& candidates, qsizetype ballotCount,
+                                                           std::span<const Election::ScoreStatistics> statistics,
+                                                           std::span<const int> preferences)
+{
+    qsizetype partialCount = candidates.size();
+    Q_ASSERT_X(statistics.size() == size_t(partialCount), "ElectionSummary::Builder::wTally", "statistics don't match candidates");
+    Q_ASSERT_X(preferences.size() == size_t(partialCount * partialCount), "ElectionSummary::Builder::wTally", "preferences don't match candidates");
+
+    wCandidates(candidates);
+
+    // Position of each of the summary's candidates within the partial tally, if present
+    qsizetype candidateCount = mArrivalCandidates.size();
+    QVarLengthArray<qsizetype, 64> partialIdx(candidateCount);
+    std::fill(partialIdx.begin(), partialIdx.end(), -1);
+    for(qsizetype p = 0; p < partialCount; p++)
+        partialIdx[mArrivalCandidates.indexOf(candidates.at(p))] = p;
+
+    int* summaryPreferences = mArrivalPreferences.data();
+    for(qsizetype a = 0; a < candidateCount; a++)
+    {
+        Election::ScoreStatistics& stats = mArrivalStatistics[a];
+        qsizetype pa = partialIdx.at(a);
+
+        // Candidates absent from the partial tally are never preferred over anyone within it
+        if(pa == -1)
+        {
+            stats.scoreCounts[0] += int(ballotCount);
+            continue;
+        }
+
+        const Election::ScoreStatistics& partialStats = statistics[pa];
+        for(int score = 0; score <= Election::ScoreStatistics::MAX_SCORE; score++)
+            stats.scoreCounts[score] += partialStats.scoreCounts[score];
+
+        int nonZero = int(ballotCount) - partialStats.count(0);
+        for(qsizetype b = 0; b < candidateCount; b++)
+        {
+            qsizetype pb = partialIdx.at(b);
+            if(pb != -1)
+                summaryPreferences[a * candidateCount + b] += preferences[pa * partialCount + pb];
+            else if(a != b)
+                summaryPreferences[a * candidateCount + b] += nonZero;
+        }
+    }
+
+    mConstruct.mBallotCount += ballotCount;
+    return *this;
+}
+
+/*!
+ *  Counts the ballots described by the summary @a partial towards the work-in-progress summary.
+ *
+ *  The seat count of @a partial is adopted if one has not already been set. @a partial must include its
+ *  head-to-head preferences.
+ *
+ *  Returns a reference to the builder.
+ *
+ *  @sa wTally() and ElectionSummary::hasPreferences().
+ */
+ElectionSummary::Builder& ElectionSummary::Builder::wSummary(const ElectionSummary& partial)
+{
+    Q_ASSERT_X(partial.hasPreferences(), "ElectionSummary::Builder::wSummary", "partial summary lacks preferences");
+
+    qsizetype partialCount = partial.candidateCount();
+    QList<int> preferences(partialCount * partialCount);
+    for(int a = 0; a < partialCount; a++)
+        for(int b = 0; b < partialCount; b++)
+            preferences[a * partialCount + b] = partial.preferences(a, b);
+
+    if(mConstruct.mSeats == 0)
+        mConstruct.mSeats = partial.seatCount();
+
+    return wTally(partial.candidates(), partial.ballotCount(),
+                  std::span<const Election::ScoreStatistics>(partial.mStatistics.constData(), partial.mStatistics.size()),
+                  std::span<const int>(preferences.constData(), preferences.size()));
+}
+
+/*!
+ *  Resets the work-in-progress summary to a null one, keeping only its name.
+ */
+void ElectionSummary::Builder::reset()
+{
+    QString name = mConstruct.mName;
+    mConstruct = ElectionSummary();
+    mConstruct.mName = name;
+
+    mArrivalCandidates.clear();
+    mArrivalStatistics.clear();
+    mArrivalPreferences.clear();
+}
+
+/*!
+ *  Completes the work-in-progress summary and returns it.
+ *
+ *  Afterwards, the builder is left as if reset() had been called.
+ */
+ElectionSummary ElectionSummary::Builder::build()
+{
+    // Assign final IDs according to name order, as is done for an Election
+    qsizetype candidateCount = mArrivalCandidates.size();
+
+    QList<int> order(candidateCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b){
+        return mArrivalCandidates.at(a) < mArrivalCandidates.at(b);
+    });
+
+    auto preferences = std::make_shared<PreferenceMatrix>(candidateCount);
+    RankSorter sorter;
+    sorter.reserve(candidateCount);
+
+    for(int id = 0; id < candidateCount; id++)
+    {
+        int arrivalId = order.at(id);
+        const QString& candidate = mArrivalCandidates.at(arrivalId);
+        const Election::ScoreStatistics& stats = mArrivalStatistics.at(arrivalId);
+
+        mConstruct.mCandidates.append(candidate);
+        mConstruct.mCandidateIds.insert(candidate, id);
+        mConstruct.mStatistics.append(stats);
+        sorter.add(id, stats.totalScore());
+
+        for(int other = 0; other < candidateCount; other++)
+            preferences->add(id, other, mArrivalPreferences.at(arrivalId * candidateCount + order.at(other)));
+    }
+
+    mConstruct.mScoreRankings = sorter.sort(mConstruct.mCandidates, Rank::Descending);
+    mConstruct.mPreferences = std::move(preferences);
+
+    // Hand off completed construct
+    ElectionSummary summary = std::move(mConstruct);
+    mConstruct.mName = summary.mName;
+    reset();
+
+    return summary;
+}
+
+}
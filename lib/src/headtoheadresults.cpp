@@ -3,6 +3,7 @@
 
 // Project Includes
 #include "star/election.h"
+#include "star/electionsummary.h"
 
 namespace Star
 {
@@ -12,195 +13,147 @@ namespace Star
 //===============================================================================================================
 
 //-Constructor---------------------------------------------------------------------------------------------------------
-//Private:
-HeadToHeadResults::HeadToHeadResults() {}
-
 //Public:
-HeadToHeadResults::HeadToHeadResults(const Election* election)
+HeadToHeadResults::HeadToHeadResults(const ElectionSummary& summary, const Election* ballots, int threadCount) :
+    mBallots(ballots),
+    mTalliedCount(0),
+    mStopped(false)
 {
-    // Get candidate list
-    QStringList candidates = election->candidates();
-
-    // Perform face-offs
-    for(auto itrA = candidates.cbegin(); itrA != candidates.cend() - 1; itrA++)
+    // Summaries with preferences (e.g. from elections with a live tally) already know all of them
+    int size = int(summary.candidateCount());
+    if(summary.mPreferences)
+    {
+        mMatrix = *summary.mPreferences;
+        mTallied.fill(true, size * size);
+        mTalliedCount = qsizetype(size) * (size - 1) / 2;
+    }
+    else
     {
-        QString opponentA = *itrA;
+        Q_ASSERT_X(ballots, "HeadToHeadResults", "summary without preferences requires ballots");
+        mMatrix = PreferenceMatrix(size);
+        mTallied.fill(false, size * size);
 
-        for(auto itrB = itrA + 1; itrB != candidates.cend(); itrB++)
+        // The calling thread tallies a share of each matchup itself
+        if(threadCount > 1)
         {
-            QString opponentB = *itrB;
-
-            // Determine pref counts
-            int prefA = 0;
-            int prefB = 0;
-
-            for(const Star::Election::Ballot& ballot : election->ballots())
-            {
-                QString pref = ballot.preference(opponentA, opponentB);
-                if(pref == opponentA)
-                    prefA++;
-                else if(pref == opponentB)
-                    prefB++;
-            }
-
-            // Update stats for candidates
-            faceOffStatsUpdate(opponentA, prefA, opponentB, prefB);
-            faceOffStatsUpdate(opponentB, prefB, opponentA, prefA);
+            mShardPool = std::make_unique<QThreadPool>();
+            mShardPool->setMaxThreadCount(threadCount - 1);
         }
     }
 }
 
 //-Instance Functions-------------------------------------------------------------------------------------------------
 //Private:
-void HeadToHeadResults::faceOffStatsUpdate(const QString& can, int canPref, const QString& opp, int oppPref)
+void HeadToHeadResults::ensureTallied(int a, int b) const
 {
-    // Update stats for candidate based on results of face-off with opponent
-    CandidateStats& cStats = mStats[can];
-    if(canPref > oppPref)
-        cStats.victories.insert(opp);
-    else if(oppPref > canPref)
-        cStats.defeats.insert(opp);
-    cStats.preferences.increase(opp, canPref);
-    cStats.antiPreferences.increase(opp, oppPref);
-}
+    if(a > b)
+        std::swap(a, b);
 
-//Public:
-int HeadToHeadResults::wins(const QString& candidate) const
-{
-    if(!mStats.contains(candidate))
-        return 0;
+    qsizetype pairIdx = qsizetype(a) * mMatrix.size() + b;
+    if(a != b && !mStopped && !mTallied.testBit(pairIdx))
+    {
+        // Sparse ballots can't be streamed per pair, so they're tallied for every pair in one pass instead
+        if(mBallots->scoreLayout() == Election::Sparse)
+            tallyAll();
+        else
+        {
+            mMatrix.tallyPair(mBallots, a, b, mShardPool.get());
+            mTallied.setBit(pairIdx);
+            mTalliedCount++;
+        }
 
-    return mStats[candidate].victories.size();
+        // Once stopped, the remaining pairs are left at zero, so no result depending on them is meaningful
+        if(mCheckpoint && !mCheckpoint(mTalliedCount))
+            mStopped = true;
+    }
 }
 
-int HeadToHeadResults::losses(const QString& candidate) const
+void HeadToHeadResults::tallyAll() const
 {
-    if(!mStats.contains(candidate))
-        return 0;
+    int threadCount = mShardPool ? mShardPool->maxThreadCount() + 1 : 1;
+    mMatrix = PreferenceMatrix(mBallots, threadCount);
 
-    return mStats[candidate].defeats.size();
+    qsizetype size = mMatrix.size();
+    mTallied.fill(true);
+    mTalliedCount = size * (size - 1) / 2;
 }
 
-int HeadToHeadResults::preferences(const QString& candidate) const
+void HeadToHeadResults::ensureTallied(int candidate, const CandidateSet& among) const
 {
-    if(!mStats.contains(candidate))
-        return 0;
-
-    return mStats[candidate].preferences.total();
+    for(int opp : among)
+        ensureTallied(candidate, opp);
 }
 
-int HeadToHeadResults::margin(const QString& candidate) const
+//Public:
+qsizetype HeadToHeadResults::untalliedCount() const
 {
-    if(!mStats.contains(candidate))
-        return 0;
-
-    auto stat = mStats[candidate];
-    return stat.preferences.total() - stat.antiPreferences.total();
+    qsizetype size = mMatrix.size();
+    return size * (size - 1) / 2 - mTalliedCount;
 }
 
-QString HeadToHeadResults::winner(const QString& candidateA, const QString& candidateB) const
+void HeadToHeadResults::setCheckpoint(const Checkpoint& checkpoint) { mCheckpoint = checkpoint; }
+
+int HeadToHeadResults::wins(int candidate, const CandidateSet& among) const
 {
-    if(!mStats.contains(candidateA) || !mStats.contains(candidateB))
-        return QString();
+    ensureTallied(candidate, among);
 
-    return mStats[candidateA].victories.contains(candidateB) ? candidateA :
-           mStats[candidateB].victories.contains(candidateA) ? candidateB :
-                                                               QString();
-}
+    int w = 0;
+    for(int opp : among)
+        if(opp != candidate && mMatrix.preferences(candidate, opp) > mMatrix.preferences(opp, candidate))
+            w++;
 
-qsizetype HeadToHeadResults::candidateCount() const { return mStats.size(); }
+    return w;
+}
 
-QSet<QString> HeadToHeadResults::candidates() const
+int HeadToHeadResults::losses(int candidate, const CandidateSet& among) const
 {
-    QSet<QString> can;
-    for(auto itr = mStats.cbegin(); itr != mStats.cend(); itr++)
-        can.insert(itr.key());
-    return can;
+    ensureTallied(candidate, among);
+
+    int l = 0;
+    for(int opp : among)
+        if(opp != candidate && mMatrix.preferences(opp, candidate) > mMatrix.preferences(candidate, opp))
+            l++;
+
+    return l;
 }
 
-void HeadToHeadResults::narrow(QSet<QString> candidates, NarrowMode mode)
+int HeadToHeadResults::preferences(int candidate, const CandidateSet& among) const
 {
-    auto shouldCull = [&](const QString& c){
-        return candidates.contains(c) && mode == Exclusive ||
-               !candidates.contains(c) && mode == Inclusive;
-    };
+    ensureTallied(candidate, among);
 
-    auto sItr = mStats.begin();
-    while(sItr != mStats.end())
-    {
-        if(shouldCull(sItr.key()))
-            sItr = mStats.erase(sItr);
-         else
-            sItr++;
-    }
+    int p = 0;
+    for(int opp : among)
+        if(opp != candidate)
+            p += mMatrix.preferences(candidate, opp);
 
-    for(CandidateStats& stat : mStats)
-    {
-        stat.defeats.removeIf([&](const QString& c){ return shouldCull(c); });
-        stat.victories.removeIf([&](const QString& c) { return shouldCull(c); });
-
-        Q_ASSERT(stat.preferences.count() == stat.antiPreferences.count());
-        QList<QString> cans = stat.preferences.components();
-        for(const QString& c : cans)
-        {
-            if(shouldCull(c))
-            {
-                stat.preferences.remove(c);
-                stat.antiPreferences.remove(c);
-            }
-        }
-    }
+    return p;
 }
 
-HeadToHeadResults HeadToHeadResults::narrowed(QSet<QString> candidates, NarrowMode mode)
+int HeadToHeadResults::margin(int candidate, const CandidateSet& among) const
 {
-    /* NOTE: Starts with an empty copy, then only fills it with the narrowed candidates, which is optimal
-     * for memory usage; however, this is also slower as there are several memory allocations involved
-     * instead of just one. The following is worse for memory but better for speed:
-     *
-     * HeadToHeadResults narrowedCopy(*this);
-     * narrowedCopy.narrow(candidates, mode);
-     * return narrowedCopy;
-     */
-
-    HeadToHeadResults narrowedCopy;
-
-    auto shouldCopy = [&](const QString& c){
-        return !candidates.contains(c) && mode == Exclusive ||
-               candidates.contains(c) && mode == Inclusive;
-    };
-
-    for(auto sItr = mStats.cbegin(); sItr != mStats.cend(); sItr++)
-    {
-        QString canA = sItr.key();
+    ensureTallied(candidate, among);
 
-        if(!shouldCopy(canA))
-            continue;
+    int m = 0;
+    for(int opp : among)
+        if(opp != candidate)
+            m += mMatrix.preferences(candidate, opp) - mMatrix.preferences(opp, candidate);
 
-        const CandidateStats& stat = *sItr;
-
-        for(const QString& canB : stat.victories)
-            if(shouldCopy(canB))
-                narrowedCopy.mStats[canA].victories.insert(canB);
+    return m;
+}
 
+int HeadToHeadResults::winner(int candidateA, int candidateB) const
+{
+    if(candidateA == candidateB)
+        return -1;
 
-        for(const QString& canB : stat.defeats)
-            if(shouldCopy(canB))
-                narrowedCopy.mStats[canA].defeats.insert(canB);
+    ensureTallied(candidateA, candidateB);
 
-        Q_ASSERT(stat.preferences.count() == stat.antiPreferences.count());
-        QList<QString> prefCans = stat.preferences.components();
-        for(const QString& canB : prefCans)
-        {
-            if(shouldCopy(canB))
-            {
-                narrowedCopy.mStats[canA].preferences.insert(canB, stat.preferences.value(canB));
-                narrowedCopy.mStats[canA].antiPreferences.insert(canB, stat.antiPreferences.value(canB));
-            }
-        }
-    }
+    int prefA = mMatrix.preferences(candidateA, candidateB);
+    int prefB = mMatrix.preferences(candidateB, candidateA);
 
-    return narrowedCopy;
+    return prefA > prefB ? candidateA :
+           prefB > prefA ? candidateB :
+                           -1;
 }
 /*! @endcond */
 }
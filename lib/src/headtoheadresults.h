@@ -1,63 +1,64 @@
 #ifndef HEADTOHEADRESULTS_H
 #define HEADTOHEADRESULTS_H
 
+// Standard Library Includes
+#include <functional>
+#include <memory>
+
 // Qt Includes
-#include <QSet>
-#include <QHash>
-#include <QString>
+#include <QBitArray>
+#include <QThreadPool>
 
-// Qx Includes
-#include <qx/core/qx-cumulation.h>
+// Project Includes
+#include "preferencematrix.h"
+#include "candidateset.h"
 
 namespace Star
 {
 /*! @cond */
 // Forward Declarations
 class Election;
+class ElectionSummary;
 
 class HeadToHeadResults
 {
-//-Class Enums-----------------------------------------------------------------------------------------------------
+//-Aliases-------------------------------------------------------------------------------------------------------------
 public:
-    enum NarrowMode{ Inclusive, Exclusive };
-
-//-Inner Structs----------------------------------------------------------------------------------------------------
-private:
-    struct CandidateStats
-    {
-        QSet<QString> victories;
-        QSet<QString> defeats;
-        Qx::Cumulation<QString, int> preferences;
-        Qx::Cumulation<QString, int> antiPreferences;
-    };
+    // Called with the number of pairs tallied so far after each one, tallying stops for good once it returns false
+    using Checkpoint = std::function<bool(qsizetype tallied)>;
 
 //-Instance Variables--------------------------------------------------------------------------------------------------
 private:
-    QHash<QString, CandidateStats> mStats;
+    const Election* mBallots; // Source of preferences not already known
+    std::unique_ptr<QThreadPool> mShardPool; // Shared by every matchup, only present when tallying with several threads
 
-//-Constructor---------------------------------------------------------------------------------------------------------
-private:
-    HeadToHeadResults();
+    // Matchups are only tallied the first time they're needed
+    mutable PreferenceMatrix mMatrix;
+    mutable QBitArray mTallied; // [a * size + b], a < b
+    mutable qsizetype mTalliedCount;
+    mutable bool mStopped;
+    Checkpoint mCheckpoint;
 
+//-Constructor---------------------------------------------------------------------------------------------------------
 public:
-    HeadToHeadResults(const Election* election);
+    HeadToHeadResults(const ElectionSummary& summary, const Election* ballots, int threadCount = 1);
 
 //-Instance Functions-------------------------------------------------------------------------------------------------
 private:
-    void faceOffStatsUpdate(const QString& can, int canPref, const QString& opp, int oppPref);
+    void tallyAll() const;
+    void ensureTallied(int a, int b) const;
+    void ensureTallied(int candidate, const CandidateSet& among) const;
 
 public:
-    int wins(const QString& candidate) const;
-    int losses(const QString& candidate) const;
-    int preferences(const QString& candidate) const;
-    int margin(const QString& candidate) const;
-    QString winner(const QString& candidateA, const QString& candidateB) const;
-
-    qsizetype candidateCount() const;
-    QSet<QString> candidates() const;
+    qsizetype untalliedCount() const;
+    void setCheckpoint(const Checkpoint& checkpoint);
 
-    void narrow(QSet<QString> candidates, NarrowMode mode);
-    HeadToHeadResults narrowed(QSet<QString> candidates, NarrowMode mode);
+    // Matchups are only considered against the other candidates within 'among'
+    int wins(int candidate, const CandidateSet& among) const;
+    int losses(int candidate, const CandidateSet& among) const;
+    int preferences(int candidate, const CandidateSet& among) const;
+    int margin(int candidate, const CandidateSet& among) const;
+    int winner(int candidateA, int candidateB) const;
 };
 /*! @endcond */
 }
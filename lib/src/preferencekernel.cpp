@@ -0,0 +1,281 @@
+// Unit Include
+#include "preferencekernel.h"
+
+// Standard Library Includes
+#include <algorithm>
+#include <bit>
+
+// Intrinsics
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define STAR_KERNEL_SSE2
+    #endif
+
+    #if defined(__GNUC__) || defined(__clang__)
+        #define STAR_KERNEL_AVX2
+        #define STAR_KERNEL_TARGET_AVX2 __attribute__((target("avx2")))
+    #elif defined(_MSC_VER)
+        #define STAR_KERNEL_AVX2
+        #define STAR_KERNEL_TARGET_AVX2
+        #include <intrin.h>
+    #endif
+
+    #include <immintrin.h>
+#endif
+
+namespace Star
+{
+/*! @cond */
+namespace PreferenceKernel
+{
+
+/* All kernels count, for each position, whether the score in A is greater than the score in B and
+ * vice versa. Scores are clamped to 0-5 by Election::Builder so they can be compared as signed bytes,
+ * and the per-lane byte counters used by the vector paths are drained into wide sums before they can
+ * overflow (255 iterations).
+ */
+namespace
+{
+    using PairCounter = PairCount(*)(const quint8*, const quint8*, qsizetype);
+
+    struct PlaneMasks
+    {
+        quint64 aOverB;
+        quint64 bOverA;
+    };
+
+    /* Compares the scores of 64 ballots at once, given as three bit planes per candidate (see
+     * Election::scorePlanes()). A score is greater than another if it has a set bit where the other
+     * doesn't, and all of the bits above that one are the same.
+     */
+    PlaneMasks comparePlanes(const quint64* planesA, const quint64* planesB)
+    {
+        quint64 same2 = ~(planesA[2] ^ planesB[2]);
+        quint64 same1 = ~(planesA[1] ^ planesB[1]);
+
+        return PlaneMasks{
+            .aOverB = (planesA[2] & ~planesB[2]) | (same2 & ((planesA[1] & ~planesB[1]) | (same1 & planesA[0] & ~planesB[0]))),
+            .bOverA = (planesB[2] & ~planesA[2]) | (same2 & ((planesB[1] & ~planesA[1]) | (same1 & planesB[0] & ~planesA[0])))
+        };
+    }
+
+    int sumWeights(quint64 mask, const int* weights)
+    {
+        // Visit only the set bits, lowest first
+        int sum = 0;
+        for(; mask; mask &= mask - 1)
+            sum += weights[std::countr_zero(mask)];
+
+        return sum;
+    }
+
+    PairCount countPairScalar(const quint8* scoresA, const quint8* scoresB, qsizetype count)
+    {
+        PairCount pc;
+        for(qsizetype i = 0; i < count; i++)
+        {
+            pc.aOverB += scoresA[i] > scoresB[i];
+            pc.bOverA += scoresB[i] > scoresA[i];
+        }
+
+        return pc;
+    }
+
+#ifdef STAR_KERNEL_SSE2
+    PairCount countPairSse2(const quint8* scoresA, const quint8* scoresB, qsizetype count)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i sumA = zero;
+        __m128i sumB = zero;
+
+        qsizetype i = 0;
+        while(count - i >= 16)
+        {
+            qsizetype chunkEnd = i + std::min((count - i) / 16, qsizetype(255)) * 16;
+            __m128i accA = zero;
+            __m128i accB = zero;
+
+            for(; i < chunkEnd; i += 16)
+            {
+                __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(scoresA + i));
+                __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(scoresB + i));
+
+                // Comparison masks are -1 where true, so subtracting them increments the counters
+                accA = _mm_sub_epi8(accA, _mm_cmpgt_epi8(a, b));
+                accB = _mm_sub_epi8(accB, _mm_cmpgt_epi8(b, a));
+            }
+
+            sumA = _mm_add_epi64(sumA, _mm_sad_epu8(accA, zero));
+            sumB = _mm_add_epi64(sumB, _mm_sad_epu8(accB, zero));
+        }
+
+        alignas(16) quint64 lanesA[2];
+        alignas(16) quint64 lanesB[2];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanesA), sumA);
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanesB), sumB);
+
+        PairCount pc = countPairScalar(scoresA + i, scoresB + i, count - i);
+        pc.aOverB += int(lanesA[0] + lanesA[1]);
+        pc.bOverA += int(lanesB[0] + lanesB[1]);
+        return pc;
+    }
+#endif
+
+#ifdef STAR_KERNEL_AVX2
+    STAR_KERNEL_TARGET_AVX2 PairCount countPairAvx2(const quint8* scoresA, const quint8* scoresB, qsizetype count)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        __m256i sumA = zero;
+        __m256i sumB = zero;
+
+        qsizetype i = 0;
+        while(count - i >= 32)
+        {
+            qsizetype chunkEnd = i + std::min((count - i) / 32, qsizetype(255)) * 32;
+            __m256i accA = zero;
+            __m256i accB = zero;
+
+            for(; i < chunkEnd; i += 32)
+            {
+                __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(scoresA + i));
+                __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(scoresB + i));
+
+                accA = _mm256_sub_epi8(accA, _mm256_cmpgt_epi8(a, b));
+                accB = _mm256_sub_epi8(accB, _mm256_cmpgt_epi8(b, a));
+            }
+
+            sumA = _mm256_add_epi64(sumA, _mm256_sad_epu8(accA, zero));
+            sumB = _mm256_add_epi64(sumB, _mm256_sad_epu8(accB, zero));
+        }
+
+        alignas(32) quint64 lanesA[4];
+        alignas(32) quint64 lanesB[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanesA), sumA);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanesB), sumB);
+
+        PairCount pc = countPairScalar(scoresA + i, scoresB + i, count - i);
+        pc.aOverB += int(lanesA[0] + lanesA[1] + lanesA[2] + lanesA[3]);
+        pc.bOverA += int(lanesB[0] + lanesB[1] + lanesB[2] + lanesB[3]);
+        return pc;
+    }
+
+    bool cpuHasAvx2()
+    {
+    #if defined(_MSC_VER) && !defined(__clang__)
+        // Check for CPU support and that the OS saves the YMM registers
+        int info[4];
+        __cpuid(info, 0);
+        if(info[0] < 7)
+            return false;
+
+        __cpuid(info, 1);
+        bool osxsave = info[2] & (1 << 27);
+        if(!osxsave || (_xgetbv(0) & 0x6) != 0x6)
+            return false;
+
+        __cpuidex(info, 7, 0);
+        return info[1] & (1 << 5);
+    #else
+        return __builtin_cpu_supports("avx2");
+    #endif
+    }
+#endif
+
+    InstructionSet detectInstructionSet()
+    {
+    #ifdef STAR_KERNEL_AVX2
+        if(cpuHasAvx2())
+            return InstructionSet::Avx2;
+    #endif
+    #ifdef STAR_KERNEL_SSE2
+        return InstructionSet::Sse2;
+    #else
+        return InstructionSet::Scalar;
+    #endif
+    }
+
+    PairCounter counterFor(InstructionSet set)
+    {
+        switch(set)
+        {
+        #ifdef STAR_KERNEL_AVX2
+            case InstructionSet::Avx2:
+                return countPairAvx2;
+        #endif
+        #ifdef STAR_KERNEL_SSE2
+            case InstructionSet::Sse2:
+                return countPairSse2;
+        #endif
+            default:
+                return countPairScalar;
+        }
+    }
+}
+
+InstructionSet instructionSet()
+{
+    static const InstructionSet set = detectInstructionSet();
+    return set;
+}
+
+PairCount countPair(const quint8* scoresA, const quint8* scoresB, qsizetype count)
+{
+    static const PairCounter counter = counterFor(instructionSet());
+    return counter(scoresA, scoresB, count);
+}
+
+PairCount countPair(const quint8* scoresA, const quint8* scoresB, qsizetype count, InstructionSet set)
+{
+    // Fall back to the best available set if the requested one isn't supported
+    if(set > instructionSet())
+        set = instructionSet();
+
+    return counterFor(set)(scoresA, scoresB, count);
+}
+
+PairCount countWeightedPair(const quint8* scoresA, const quint8* scoresB, const int* weights, qsizetype count)
+{
+    /* Weighted ballots are usually the distinct sets of scores of an election, of which there are
+     * comparatively few, so a plain loop is sufficient. It is kept branchless so that the compiler is
+     * free to vectorize it.
+     */
+    PairCount pc;
+    for(qsizetype i = 0; i < count; i++)
+    {
+        pc.aOverB += (scoresA[i] > scoresB[i]) * weights[i];
+        pc.bOverA += (scoresB[i] > scoresA[i]) * weights[i];
+    }
+
+    return pc;
+}
+
+PairCount countPlanePair(const quint64* planesA, const quint64* planesB, qsizetype groupCount)
+{
+    PairCount pc;
+    for(qsizetype g = 0; g < groupCount; g++, planesA += 3, planesB += 3)
+    {
+        PlaneMasks masks = comparePlanes(planesA, planesB);
+        pc.aOverB += std::popcount(masks.aOverB);
+        pc.bOverA += std::popcount(masks.bOverA);
+    }
+
+    return pc;
+}
+
+PairCount countWeightedPlanePair(const quint64* planesA, const quint64* planesB, const int* weights, qsizetype groupCount)
+{
+    // Padding ballots at the end of the planes compare as equal, so their missing weights are never read
+    PairCount pc;
+    for(qsizetype g = 0; g < groupCount; g++, planesA += 3, planesB += 3, weights += 64)
+    {
+        PlaneMasks masks = comparePlanes(planesA, planesB);
+        pc.aOverB += sumWeights(masks.aOverB, weights);
+        pc.bOverA += sumWeights(masks.bOverA, weights);
+    }
+
+    return pc;
+}
+
+}
+/*! @endcond */
+}
@@ -0,0 +1,32 @@
+#ifndef PREFERENCEKERNEL_H
+#define PREFERENCEKERNEL_H
+
+// Qt Includes
+#include <QtGlobal>
+
+namespace Star
+{
+/*! @cond */
+namespace PreferenceKernel
+{
+
+enum class InstructionSet { Scalar, Sse2, Avx2 };
+
+struct PairCount
+{
+    int aOverB = 0;
+    int bOverA = 0;
+};
+
+InstructionSet instructionSet();
+PairCount countPair(const quint8* scoresA, const quint8* scoresB, qsizetype count);
+PairCount countPair(const quint8* scoresA, const quint8* scoresB, qsizetype count, InstructionSet set);
+PairCount countWeightedPair(const quint8* scoresA, const quint8* scoresB, const int* weights, qsizetype count);
+PairCount countPlanePair(const quint64* planesA, const quint64* planesB, qsizetype groupCount);
+PairCount countWeightedPlanePair(const quint64* planesA, const quint64* planesB, const int* weights, qsizetype groupCount);
+
+}
+/*! @endcond */
+}
+
+#endif // PREFERENCEKERNEL_H
@@ -0,0 +1,291 @@
+// Unit Include
+#include "preferencematrix.h"
+
+// Standard Library Includes
+#include <algorithm>
+
+// Qt Includes
+#include <QThreadPool>
+#include <QVarLengthArray>
+
+// Project Includes
+#include "star/election.h"
+
+namespace Star
+{
+/*! @cond */
+//===============================================================================================================
+// PreferenceMatrix
+//===============================================================================================================
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+//Public:
+PreferenceMatrix::PreferenceMatrix() :
+    mSize(0)
+{}
+
+PreferenceMatrix::PreferenceMatrix(int size) :
+    mSize(size),
+    mCounts(size * size, 0)
+{}
+
+PreferenceMatrix::PreferenceMatrix(const Election* election, int threadCount) :
+    PreferenceMatrix(election->candidateCount())
+{
+    qsizetype ballotCount = election->ballotCount();
+    int shards = shardCount(ballotCount, threadCount);
+
+    if(shards == 1)
+        tally(election, 0, ballotCount);
+    else
+    {
+        // Each shard tallies into its own partial matrix so that no synchronization is needed until they are all summed at the end
+        QList<PreferenceMatrix> partials;
+        partials.reserve(shards);
+        for(int i = 0; i < shards; i++)
+            partials.append(PreferenceMatrix(mSize));
+        PreferenceMatrix* partialData = partials.data();
+
+        runShards(ballotCount, shards, [=](int i, qsizetype shardStart, qsizetype shardEnd){
+            partialData[i].tally(election, shardStart, shardEnd);
+        });
+
+        // Reduce
+        for(const PreferenceMatrix& partial : std::as_const(partials))
+            merge(partial);
+    }
+
+    // The sparse tally leaves out every ballot's preferences for scored candidates over unscored ones until now
+    if(election->scoreLayout() == Election::Sparse)
+        addScoredCounts(election);
+}
+
+//-Class Functions----------------------------------------------------------------------------------------------------
+//Private:
+int PreferenceMatrix::shardCount(qsizetype ballotCount, int threadCount)
+{
+    // Split the ballots into shards of whole blocks, at most one per thread
+    qsizetype blockCount = (ballotCount + BALLOT_BLOCK_SIZE - 1) / BALLOT_BLOCK_SIZE;
+    return std::max(qsizetype(1), std::min(qsizetype(threadCount), blockCount));
+}
+
+PreferenceKernel::PairCount PreferenceMatrix::countRange(const Election* election, int a, int b, qsizetype ballotStart, qsizetype ballotEnd)
+{
+    /* The comparisons themselves are handled by the fastest kernel for how the election stores its
+     * scores, and whether or not they need to be weighted. Ranges always begin on a block boundary,
+     * which is also the boundary of a group of bit planes. Sparse ballots have no per-candidate scores
+     * to stream, so they're only ever tallied for all pairs at once by tallySparse().
+     */
+    Q_ASSERT(election->scoreLayout() != Election::Sparse);
+    const int* weights = election->isWeighted() ? election->weights().data() + ballotStart : nullptr;
+
+    if(election->scoreLayout() == Election::BitPlanes)
+    {
+        Q_ASSERT(ballotStart % PLANE_WIDTH == 0);
+        qsizetype groupOffset = ballotStart / PLANE_WIDTH * PLANE_COUNT;
+        qsizetype groupCount = (ballotEnd - ballotStart + PLANE_WIDTH - 1) / PLANE_WIDTH;
+        const quint64* planesA = election->scorePlanes(a).data() + groupOffset;
+        const quint64* planesB = election->scorePlanes(b).data() + groupOffset;
+
+        return weights ? PreferenceKernel::countWeightedPlanePair(planesA, planesB, weights, groupCount) :
+                         PreferenceKernel::countPlanePair(planesA, planesB, groupCount);
+    }
+
+    const quint8* scoresA = election->scores(a).data() + ballotStart;
+    const quint8* scoresB = election->scores(b).data() + ballotStart;
+    qsizetype count = ballotEnd - ballotStart;
+
+    return weights ? PreferenceKernel::countWeightedPair(scoresA, scoresB, weights, count) :
+                     PreferenceKernel::countPair(scoresA, scoresB, count);
+}
+
+template<typename Work>
+void PreferenceMatrix::runShards(qsizetype ballotCount, int shardCount, Work work, QThreadPool* pool)
+{
+    if(shardCount == 1)
+    {
+        work(0, 0, ballotCount);
+        return;
+    }
+
+    /* The calling thread handles the last shard itself, and a dedicated pool is used so that this
+     * is safe to do from within another pool's task. Callers that run shards repeatedly can provide
+     * their own so that its threads are kept between runs instead of being started every time.
+     */
+    QThreadPool localPool;
+    QThreadPool& shardPool = pool ? *pool : localPool;
+    if(!pool)
+        localPool.setMaxThreadCount(shardCount - 1);
+
+    qsizetype blockCount = (ballotCount + BALLOT_BLOCK_SIZE - 1) / BALLOT_BLOCK_SIZE;
+    qsizetype blocksPerShard = blockCount / shardCount;
+    qsizetype extraBlocks = blockCount % shardCount;
+    qsizetype shardStart = 0;
+
+    for(int i = 0; i < shardCount; i++)
+    {
+        qsizetype shardBlocks = blocksPerShard + (i < extraBlocks ? 1 : 0);
+        qsizetype shardEnd = std::min(ballotCount, shardStart + shardBlocks * BALLOT_BLOCK_SIZE);
+
+        if(i == shardCount - 1)
+            work(i, shardStart, shardEnd);
+        else
+            shardPool.start([=]{ work(i, shardStart, shardEnd); });
+
+        shardStart = shardEnd;
+    }
+
+    shardPool.waitForDone();
+}
+
+//-Instance Functions-------------------------------------------------------------------------------------------------
+//Private:
+void PreferenceMatrix::tally(const Election* election, qsizetype ballotStart, qsizetype ballotEnd)
+{
+    if(election->scoreLayout() == Election::Sparse)
+    {
+        tallySparse(election, ballotStart, ballotEnd);
+        return;
+    }
+
+    /* Make a single pass over the ballots, one block at a time, tallying every candidate pair
+     * within the block before moving on. Since scores are stored per-candidate, this keeps the
+     * portion of each candidate's scores that is being compared in cache for all pairs, instead
+     * of streaming the entire ballot set once per pair.
+     */
+    for(qsizetype blockStart = ballotStart; blockStart < ballotEnd; blockStart += BALLOT_BLOCK_SIZE)
+    {
+        qsizetype blockEnd = std::min(blockStart + BALLOT_BLOCK_SIZE, ballotEnd);
+
+        for(int a = 0; a < mSize - 1; a++)
+        {
+            for(int b = a + 1; b < mSize; b++)
+            {
+                PreferenceKernel::PairCount pc = countRange(election, a, b, blockStart, blockEnd);
+                add(a, b, pc.aOverB);
+                add(b, a, pc.bOverA);
+            }
+        }
+    }
+}
+
+void PreferenceMatrix::tallySparse(const Election* election, qsizetype ballotStart, qsizetype ballotEnd)
+{
+    /* A ballot prefers each candidate it scored over every candidate it didn't, so a prefers a over b
+     * unless b was also scored and a's score isn't higher. Only those exceptions are tallied here, by
+     * visiting the pairs of candidates each ballot actually scored and subtracting the ballot from
+     * every pair it doesn't prefer. addScoredCounts() then credits each candidate with every ballot
+     * that scored it, which comes from the statistics instead of the ballots.
+     *
+     * Since subtraction commutes with the merge of partial matrices, this works across shards as well.
+     */
+    for(qsizetype i = ballotStart; i < ballotEnd; i++)
+    {
+        std::span<const Election::SparseScore> entries = election->sparseScores(i);
+        int weight = election->ballotWeight(i);
+
+        for(size_t x = 0; x + 1 < entries.size(); x++)
+        {
+            for(size_t y = x + 1; y < entries.size(); y++)
+            {
+                const Election::SparseScore& a = entries[x];
+                const Election::SparseScore& b = entries[y];
+                if(a.score <= b.score)
+                    add(a.candidateId, b.candidateId, -weight);
+                if(b.score <= a.score)
+                    add(b.candidateId, a.candidateId, -weight);
+            }
+        }
+    }
+}
+
+void PreferenceMatrix::addScoredCounts(const Election* election)
+{
+    for(int a = 0; a < mSize; a++)
+    {
+        int scored = int(election->totalWeight()) - election->statistics(a).count(0);
+        for(int b = 0; b < mSize; b++)
+            if(b != a)
+                add(a, b, scored);
+    }
+}
+
+//Public:
+int PreferenceMatrix::size() const { return mSize; }
+int PreferenceMatrix::preferences(int a, int b) const { return mCounts.at(a * mSize + b); }
+void PreferenceMatrix::add(int a, int b, int count) { mCounts[a * mSize + b] += count; }
+
+void PreferenceMatrix::tallyPair(const Election* election, int a, int b, QThreadPool* pool)
+{
+    /* Tally just the one matchup over all ballots, which is a single streaming pass over two candidates' scores.
+     * Matchups are tallied one after another, so any extra threads come from the caller's pool, which keeps
+     * them alive across matchups, along with the calling thread itself.
+     */
+    qsizetype ballotCount = election->ballotCount();
+    int shards = shardCount(ballotCount, pool ? pool->maxThreadCount() + 1 : 1);
+
+    QVarLengthArray<PreferenceKernel::PairCount, 16> partials(shards);
+    PreferenceKernel::PairCount* partialData = partials.data();
+
+    runShards(ballotCount, shards, [=](int i, qsizetype shardStart, qsizetype shardEnd){
+        partialData[i] = countRange(election, a, b, shardStart, shardEnd);
+    }, pool);
+
+    for(const PreferenceKernel::PairCount& pc : std::as_const(partials))
+    {
+        add(a, b, pc.aOverB);
+        add(b, a, pc.bOverA);
+    }
+}
+
+void PreferenceMatrix::addBallot(std::span<const quint8> scores, int weight)
+{
+    // Tally a single ballot, positionally by candidate; a negative weight removes it
+    Q_ASSERT(scores.size() == size_t(mSize));
+
+    for(int a = 0; a < mSize - 1; a++)
+    {
+        for(int b = a + 1; b < mSize; b++)
+        {
+            if(scores[a] > scores[b])
+                add(a, b, weight);
+            else if(scores[b] > scores[a])
+                add(b, a, weight);
+        }
+    }
+}
+
+void PreferenceMatrix::addSparseBallot(std::span<const Election::SparseScore> scores, int weight)
+{
+    // Same as addBallot(), but for only the nonzero scores of the ballot, following the approach of tallySparse()
+    for(const Election::SparseScore& entry : scores)
+        for(int b = 0; b < mSize; b++)
+            if(b != entry.candidateId)
+                add(entry.candidateId, b, weight);
+
+    for(size_t x = 0; x + 1 < scores.size(); x++)
+    {
+        for(size_t y = x + 1; y < scores.size(); y++)
+        {
+            const Election::SparseScore& a = scores[x];
+            const Election::SparseScore& b = scores[y];
+            if(a.score <= b.score)
+                add(a.candidateId, b.candidateId, -weight);
+            if(b.score <= a.score)
+                add(b.candidateId, a.candidateId, -weight);
+        }
+    }
+}
+
+void PreferenceMatrix::merge(const PreferenceMatrix& other)
+{
+    Q_ASSERT(other.mSize == mSize);
+
+    int* counts = mCounts.data();
+    const int* otherCounts = other.mCounts.constData();
+    for(qsizetype i = 0; i < mCounts.size(); i++)
+        counts[i] += otherCounts[i];
+}
+
+/*! @endcond */
+}
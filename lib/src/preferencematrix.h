@@ -0,0 +1,67 @@
+#ifndef PREFERENCEMATRIX_H
+#define PREFERENCEMATRIX_H
+
+// Standard Library Includes
+#include <span>
+
+// Qt Includes
+#include <QList>
+
+// Qt Forward Declarations
+class QThreadPool;
+
+// Project Includes
+#include "star/election.h"
+#include "preferencekernel.h"
+
+namespace Star
+{
+/*! @cond */
+class PreferenceMatrix
+{
+//-Class Variables------------------------------------------------------------------------------------------------------
+private:
+    // Number of ballots processed at a time, chosen so that a block of every candidate's scores stays in cache
+    static inline const qsizetype BALLOT_BLOCK_SIZE = 4096;
+
+    // Shape of Election::scorePlanes()
+    static inline const qsizetype PLANE_WIDTH = 64;
+    static inline const qsizetype PLANE_COUNT = 3;
+
+//-Instance Variables--------------------------------------------------------------------------------------------------
+private:
+    int mSize;
+    QList<int> mCounts; // [a * size + b] = Ballots that prefer a over b
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+public:
+    PreferenceMatrix();
+    PreferenceMatrix(int size);
+    PreferenceMatrix(const Election* election, int threadCount = 1);
+
+//-Class Functions----------------------------------------------------------------------------------------------------
+private:
+    static int shardCount(qsizetype ballotCount, int threadCount);
+    static PreferenceKernel::PairCount countRange(const Election* election, int a, int b, qsizetype ballotStart, qsizetype ballotEnd);
+    template<typename Work>
+    static void runShards(qsizetype ballotCount, int shardCount, Work work, QThreadPool* pool = nullptr);
+
+//-Instance Functions-------------------------------------------------------------------------------------------------
+private:
+    void tally(const Election* election, qsizetype ballotStart, qsizetype ballotEnd);
+    void tallySparse(const Election* election, qsizetype ballotStart, qsizetype ballotEnd);
+    void addScoredCounts(const Election* election);
+
+public:
+    int size() const;
+    int preferences(int a, int b) const;
+    void tallyPair(const Election* election, int a, int b, QThreadPool* pool = nullptr);
+    void add(int a, int b, int count);
+    void addBallot(std::span<const quint8> scores, int weight);
+    void addSparseBallot(std::span<const Election::SparseScore> scores, int weight);
+    void merge(const PreferenceMatrix& other);
+};
+/*! @endcond */
+}
+
+#endif // PREFERENCEMATRIX_H
@@ -0,0 +1,113 @@
+// Unit Include
+#include "ranksorter.h"
+
+// Standard Library Includes
+#include <algorithm>
+
+namespace Star
+{
+/*! @cond */
+//===============================================================================================================
+// RankSorter
+//===============================================================================================================
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+//Public:
+RankSorter::RankSorter() {}
+
+//-Instance Functions-------------------------------------------------------------------------------------------------
+//Private:
+void RankSorter::countingSort(int minValue, int maxValue, Rank::Order order)
+{
+    // Bucket position of each value, in the requested order
+    const auto key = [=](int value){ return order == Rank::Ascending ? value - minValue : maxValue - value; };
+
+    QVarLengthArray<qsizetype, INLINE_ENTRIES * COUNTING_RANGE_FACTOR> offsets(qsizetype(maxValue) - minValue + 2);
+    std::fill(offsets.begin(), offsets.end(), 0);
+
+    for(const Entry& e : std::as_const(mEntries))
+        offsets[key(e.value) + 1]++;
+
+    for(qsizetype i = 1; i < offsets.size(); i++)
+        offsets[i] += offsets[i - 1];
+
+    // Stable, so entries of equal value keep their insertion order
+    QVarLengthArray<Entry, INLINE_ENTRIES> sorted(mEntries.size());
+    for(const Entry& e : std::as_const(mEntries))
+        sorted[offsets[key(e.value)]++] = e;
+
+    mEntries = sorted;
+}
+
+void RankSorter::comparisonSort(Rank::Order order)
+{
+    if(order == Rank::Ascending)
+        std::stable_sort(mEntries.begin(), mEntries.end(), [](const Entry& a, const Entry& b){ return a.value < b.value; });
+    else
+        std::stable_sort(mEntries.begin(), mEntries.end(), [](const Entry& a, const Entry& b){ return a.value > b.value; });
+}
+
+void RankSorter::orderEntries(Rank::Order order)
+{
+    // Order entries by value, preferring a counting sort when the values are densely packed
+    auto [minItr, maxItr] = std::minmax_element(mEntries.cbegin(), mEntries.cend(),
+                                                [](const Entry& a, const Entry& b){ return a.value < b.value; });
+    int minValue = minItr->value;
+    int maxValue = maxItr->value;
+
+    if(qint64(maxValue) - minValue < qint64(mEntries.size()) * COUNTING_RANGE_FACTOR)
+        countingSort(minValue, maxValue, order);
+    else
+        comparisonSort(order);
+}
+
+template<typename R, typename Insert>
+QList<R> RankSorter::group(qsizetype maxRanks, R emptyRank, Insert insert) const
+{
+    // Group runs of equal value, stopping once enough ranks have been formed
+    QList<R> rankings;
+    for(const Entry& e : std::as_const(mEntries))
+    {
+        if(rankings.isEmpty() || rankings.last().value != e.value)
+        {
+            if(rankings.size() == maxRanks)
+                break;
+
+            emptyRank.value = e.value;
+            rankings.append(emptyRank);
+        }
+
+        insert(rankings.last(), e.id);
+    }
+
+    return rankings;
+}
+
+//Public:
+void RankSorter::reserve(qsizetype size) { mEntries.reserve(size); }
+void RankSorter::add(int id, int value) { mEntries.append(Entry{.id = id, .value = value}); }
+void RankSorter::clear() { mEntries.clear(); }
+
+QList<Rank> RankSorter::sort(const QStringList& names, Rank::Order order, qsizetype maxRanks)
+{
+    if(mEntries.isEmpty() || maxRanks == 0)
+        return {};
+
+    orderEntries(order);
+    return group(maxRanks, Rank{.value = 0, .candidates = {}}, [&](Rank& rank, int id){
+        rank.candidates.insert(names.at(id));
+    });
+}
+
+QList<CandidateRank> RankSorter::sortIds(int candidateCount, Rank::Order order, qsizetype maxRanks)
+{
+    if(mEntries.isEmpty() || maxRanks == 0)
+        return {};
+
+    orderEntries(order);
+    return group(maxRanks, CandidateRank{.value = 0, .candidates = CandidateSet(candidateCount)}, [](CandidateRank& rank, int id){
+        rank.candidates.insert(id);
+    });
+}
+/*! @endcond */
+}
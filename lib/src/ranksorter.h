@@ -0,0 +1,66 @@
+#ifndef RANKSORTER_H
+#define RANKSORTER_H
+
+// Qt Includes
+#include <QVarLengthArray>
+#include <QStringList>
+
+// Project Includes
+#include "star/rank.h"
+#include "candidateset.h"
+
+namespace Star
+{
+/*! @cond */
+
+class RankSorter
+{
+//-Inner Classes----------------------------------------------------------------------------------------------------
+public:
+    struct Entry
+    {
+        int id;
+        int value;
+    };
+
+//-Class Variables------------------------------------------------------------------------------------------------------
+private:
+    static const int INLINE_ENTRIES = 64;
+
+    /* Values are counting sorted when their spread is at most this many times the number of entries, which
+     * covers the small domains of head-to-head counts and most score totals; otherwise, they're compared.
+     */
+    static const int COUNTING_RANGE_FACTOR = 8;
+
+public:
+    static const qsizetype ALL_RANKS = -1;
+
+//-Instance Variables--------------------------------------------------------------------------------------------------
+private:
+    QVarLengthArray<Entry, INLINE_ENTRIES> mEntries;
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+public:
+    RankSorter();
+
+//-Instance Functions-------------------------------------------------------------------------------------------------
+private:
+    void countingSort(int minValue, int maxValue, Rank::Order order);
+    void comparisonSort(Rank::Order order);
+    void orderEntries(Rank::Order order);
+
+    template<typename R, typename Insert>
+    QList<R> group(qsizetype maxRanks, R emptyRank, Insert insert) const;
+
+public:
+    void reserve(qsizetype size);
+    void add(int id, int value);
+    void clear();
+
+    QList<Rank> sort(const QStringList& names, Rank::Order order, qsizetype maxRanks = ALL_RANKS);
+    QList<CandidateRank> sortIds(int candidateCount, Rank::Order order, qsizetype maxRanks = ALL_RANKS);
+};
+/*! @endcond */
+}
+
+#endif // RANKSORTER_H
@@ -3,6 +3,8 @@
 #include "reference/calculatoroptions_p.h"
 #include "reference/categoryconfig_p.h"
 #include "reference/ballotbox_p.h"
+#include "reference/binarybox_p.h"
+#include "reference/binarysummary_p.h"
 #include "reference/resultset_p.h"
 
 // Qx Includes
@@ -39,6 +41,77 @@
  *
  *  Example:
  *  @snippet reference.cpp Input Format INI
+ *
+ *  Categories with more than 64 candidates, which in practice are made up mostly of write-ins, are loaded with their
+ *  scores stored sparsely (see Election::Sparse), since each voter will have only scored a few of them.
+ *
+ *  If only the outcome of each category is needed, the same input can instead be reduced to a list of
+ *  ElectionSummary objects with summariesFromReferenceInput(), which discards each ballot as soon as it has been
+ *  counted so that the memory required does not grow with the number of ballots.
+ *  @endparblock
+ *
+ *  @par Pattern Tallies
+ *  @parblock
+ *  When ballots have already been aggregated elsewhere, the CSV of the reference input format can be replaced with a
+ *  pattern tally, which lists each distinct set of scores given within a category along with the number of ballots
+ *  that gave it. A pattern tally is loaded with the same INI file via electionsFromPatternInput() or
+ *  summariesFromPatternInput(), and each of its rows is counted as a single weighted ballot instead of being expanded
+ *  into individual ones.
+ *
+ *  The CSV should consist of the same header row as the reference input format, followed by one row per pattern. The
+ *  first field of a pattern row is the name of its category as given in the INI file, the second is the number of
+ *  ballots with that pattern (1 or greater), and the remainder are the scores (0-5) given to each candidate of that
+ *  category only, in the order they appear in the header row. Rows of different categories can be freely interleaved,
+ *  and the same pattern can appear more than once, in which case its counts are combined.
+ *
+ *  Example (equivalent to the reference input format example, plus 40 more ballots):
+ *  @snippet reference.cpp Input Format Pattern CSV
+ *
+ *  Elections loaded this way consist entirely of weighted ballots (see Election::isWeighted()) that have no voter
+ *  details.
+ *  @endparblock
+ *
+ *  @par Binary Ballot Boxes
+ *  @parblock
+ *  Since parsing the reference input format is relatively slow for large data sets, a list of prepared elections can
+ *  be saved in a compact binary form via electionsToBinaryOutput() and later reloaded with electionsFromBinaryInput()
+ *  with minimal processing.
+ *
+ *  A binary ballot box is a versioned container that consists of a header, a table that holds the name, seat count,
+ *  and candidates of each category, and then the packed scores of each category laid out exactly as they are within
+ *  an Election (i.e. candidate-major), which allows them to be used without any parsing. Optionally, the file can
+ *  end with a checksum of its contents, which is verified when the file is loaded. All values are little-endian:
+ *
+ *  @li Header - "STARBBOX" (8 bytes), version (uint16), flags (uint16, 0x1 = checksum present), category count
+ *  (uint32), ballot count (uint64)
+ *  @li Category table - For each category: name, seat count (uint32), candidate count (uint32), candidate names; each
+ *  string is stored as its UTF-8 byte count (uint32) followed by its bytes
+ *  @li Padding - Zeros up to the next multiple of 8 bytes
+ *  @li Scores - For each category: candidate count * ballot count bytes, one score (0-5) per byte
+ *  @li Checksum - MD5 hash of all preceding bytes (16 bytes), if present
+ *
+ *  Voter names are not stored, so the ballots of a loaded box only have anonymous names.
+ *  @endparblock
+ *
+ *  @par Binary Summaries
+ *  @parblock
+ *  A list of election summaries, such as those of a single precinct, can be saved via summariesToBinaryOutput() and
+ *  later reloaded with summariesFromBinaryInput(). Since a summary does not grow with the number of ballots, these
+ *  files are small, and the summaries of several precincts can be combined with ElectionSummary::Builder::wSummary()
+ *  to produce exactly the summary of all of their ballots together.
+ *
+ *  A binary summary consists of the following, with all values being little-endian:
+ *  @li Magic - The ASCII characters "STARSUMM" (8 bytes)
+ *  @li Version - Format version (2 bytes)
+ *  @li Flags - Bit 0 is set if a checksum is present (2 bytes)
+ *  @li Category Count (4 bytes)
+ *  @li Categories - For each category: name, seat count (4 bytes), ballot count (8 bytes), candidate count (4 bytes),
+ *  the candidates' names, then for each candidate its number of ballots with each score from 0 to 5 (6 * 4 bytes),
+ *  and finally the number of ballots that prefer each candidate over each other candidate
+ *  (candidate count * candidate count * 4 bytes, row-major)
+ *  @li Checksum - MD5 hash of all preceding bytes (16 bytes), if present
+ *
+ *  Strings are stored as their UTF-8 byte count (4 bytes) followed by their UTF-8 bytes.
  *  @endparblock
  *
  *  @par Reference Expected Results
@@ -105,6 +178,21 @@ namespace Star
  *  An error occurred while parsing a reference expected result set.
  */
 
+/*!
+ *  @var ReferenceErrorType ReferenceErrorType::CalcOptions
+ *  An error occurred while parsing a reference calculator options set.
+ */
+
+/*!
+ *  @var ReferenceErrorType ReferenceErrorType::BinaryBallotBox
+ *  An error occurred while reading or writing a binary ballot box.
+ */
+
+/*!
+ *  @var ReferenceErrorType ReferenceErrorType::BinarySummary
+ *  An error occurred while reading or writing a binary summary.
+ */
+
 //-Namespace Structs-----------------------------------------------------------------------------------------------------
 /*!
  *  @struct ReferenceError star/reference.h
@@ -139,75 +227,97 @@ namespace Star
 
 namespace
 {
-    QList<Election> electionTransform(const RefBallotBox& box, uint seatCount)
+    ReferenceError qxErrToRefError(ReferenceErrorType type, const Qx::Error& error)
     {
-        QList<Election> views;
+        if(!error.isValid())
+            return ReferenceError();
 
-        // Create an election for each category
-        for(qsizetype cIdx = 0; cIdx < box.categories().size(); cIdx++)
-        {
-            // Get current category
-            const RefCategory& rCategory = box.categories()[cIdx];
+        return ReferenceError{ .type = type, .error = error.primary(), .errorDetails = error.secondary() };
+    }
+}
 
-            // Initialize election builder
-            Election::Builder eBuilder(rCategory.name);
+//-Namespace-Functions--------------------------------------------------------------------------------
+/*!
+ *  @param[out] returnBuffer A list of elections, prepared with the provided data.
+ *  @param[in] categoryConfigPath The path to the category config INI file.
+ *  @param[in] ballotBoxPath The path to the ballot box CSV file.
+ *  @return An error object containing error details if the operation fails.
+ */
+ReferenceError electionsFromReferenceInput(QList<Election>& returnBuffer,
+                                            const QString& categoryConfigPath,
+                                            const QString& ballotBoxPath)
+{
+    // Clear return buffer
+    returnBuffer.clear();
 
-            // Create category specific ballots
-            for(qsizetype bIdx = 0; bIdx < box.ballots().size(); bIdx++)
-            {
-                // Get current ballot
-                const RefBallot& rBallot = box.ballots()[bIdx];
+    // Status tracker
+    Qx::Error errorStatus;
 
-                // Get votes that pertain to category
-                const QList<int>& categoryVotes = rBallot.votes[cIdx];
+    // Read category config
+    RefCategoryConfig cc;
+    RefCategoryConfig::Reader ccReader(&cc, categoryConfigPath);
+    if((errorStatus = ccReader.readInto()).isValid())
+        return qxErrToRefError(ReferenceErrorType::CategoryConfig, errorStatus);
 
-                // List to fill with candidate mapped votes in standard form
-                QList<Election::Vote> mappedVotes;
+    // Read ballot box, which streams ballots directly into an election per category
+    RefBallotBox bb;
+    RefBallotBox::Reader bbReader(&bb, ballotBoxPath, &cc);
+    if((errorStatus = bbReader.readInto()).isValid())
+        return qxErrToRefError(ReferenceErrorType::BallotBox, errorStatus);
 
-                // Map votes to candidates, convert to standard Vote, add to list
-                for(qsizetype nIdx = 0; nIdx < categoryVotes.size(); nIdx++)
-                {
-                    Election::Vote stdVote{.candidate = rCategory.candidates[nIdx], .score = categoryVotes[nIdx]};
-                    mappedVotes.append(stdVote);
-                }
+    // Finish elections
+    returnBuffer = bb.elections(cc.seats());
 
-                // Create standard voter (For now, just set the anonymous name to "Voter N")
-                static const QString anonTemplate = QStringLiteral("Voter %1");
-                Election::Voter stdVoter{.name = rBallot.voter, .anonymousName = anonTemplate.arg(bIdx)};
+    return ReferenceError();
+}
 
-                // Add ballot to builder
-                eBuilder.wBallot(stdVoter, mappedVotes);
-            }
+/*!
+ *  @param[out] returnBuffer A list of election summaries, one per category, prepared with the provided data.
+ *  @param[in] categoryConfigPath The path to the category config INI file.
+ *  @param[in] ballotBoxPath The path to the ballot box CSV file.
+ *  @return An error object containing error details if the operation fails.
+ *
+ *  @sa electionsFromReferenceInput() and Calculator::calculateResult(const ElectionSummary&).
+ */
+ReferenceError summariesFromReferenceInput(QList<ElectionSummary>& returnBuffer,
+                                            const QString& categoryConfigPath,
+                                            const QString& ballotBoxPath)
+{
+    // Clear return buffer
+    returnBuffer.clear();
 
-            // Set seat count
-            eBuilder.wSeatCount(seatCount);
+    // Status tracker
+    Qx::Error errorStatus;
 
-            // Build election and add to list
-            views.append(eBuilder.build());
-        }
+    // Read category config
+    RefCategoryConfig cc;
+    RefCategoryConfig::Reader ccReader(&cc, categoryConfigPath);
+    if((errorStatus = ccReader.readInto()).isValid())
+        return qxErrToRefError(ReferenceErrorType::CategoryConfig, errorStatus);
 
-        return views;
-    }
+    // Read ballot box, which counts each ballot towards a summary per category and then discards it
+    RefBallotBox bb(RefBallotBox::Summaries);
+    RefBallotBox::Reader bbReader(&bb, ballotBoxPath, &cc);
+    if((errorStatus = bbReader.readInto()).isValid())
+        return qxErrToRefError(ReferenceErrorType::BallotBox, errorStatus);
 
-    ReferenceError qxErrToRefError(ReferenceErrorType type, const Qx::Error& error)
-    {
-        if(!error.isValid())
-            return ReferenceError();
+    // Finish summaries
+    returnBuffer = bb.summaries(cc.seats());
 
-        return ReferenceError{ .type = type, .error = error.primary(), .errorDetails = error.secondary() };
-    }
+    return ReferenceError();
 }
 
-//-Namespace-Functions--------------------------------------------------------------------------------
 /*!
  *  @param[out] returnBuffer A list of elections, prepared with the provided data.
  *  @param[in] categoryConfigPath The path to the category config INI file.
- *  @param[in] ballotBoxPath The path to the ballot box CSV file.
+ *  @param[in] patternTallyPath The path to the pattern tally CSV file.
  *  @return An error object containing error details if the operation fails.
+ *
+ *  @sa electionsFromReferenceInput().
  */
-ReferenceError electionsFromReferenceInput(QList<Election>& returnBuffer,
-                                            const QString& categoryConfigPath,
-                                            const QString& ballotBoxPath)
+ReferenceError electionsFromPatternInput(QList<Election>& returnBuffer,
+                                          const QString& categoryConfigPath,
+                                          const QString& patternTallyPath)
 {
     // Clear return buffer
     returnBuffer.clear();
@@ -221,19 +331,117 @@ ReferenceError electionsFromReferenceInput(QList<Election>& returnBuffer,
     if((errorStatus = ccReader.readInto()).isValid())
         return qxErrToRefError(ReferenceErrorType::CategoryConfig, errorStatus);
 
-    // Read ballot box
+    // Read pattern tally, which adds each pattern to its category's election as one weighted ballot
     RefBallotBox bb;
-    RefBallotBox::Reader bbReader(&bb, ballotBoxPath, &cc);
+    RefBallotBox::Reader bbReader(&bb, patternTallyPath, &cc, RefBallotBox::Patterns);
     if((errorStatus = bbReader.readInto()).isValid())
         return qxErrToRefError(ReferenceErrorType::BallotBox, errorStatus);
 
-    // Create elections from standard ballot box
+    // Finish elections
+    returnBuffer = bb.elections(cc.seats());
+
+    return ReferenceError();
+}
+
+/*!
+ *  @param[out] returnBuffer A list of election summaries, one per category, prepared with the provided data.
+ *  @param[in] categoryConfigPath The path to the category config INI file.
+ *  @param[in] patternTallyPath The path to the pattern tally CSV file.
+ *  @return An error object containing error details if the operation fails.
+ *
+ *  @sa summariesFromReferenceInput().
+ */
+ReferenceError summariesFromPatternInput(QList<ElectionSummary>& returnBuffer,
+                                          const QString& categoryConfigPath,
+                                          const QString& patternTallyPath)
+{
+    // Clear return buffer
+    returnBuffer.clear();
+
+    // Status tracker
+    Qx::Error errorStatus;
+
+    // Read category config
+    RefCategoryConfig cc;
+    RefCategoryConfig::Reader ccReader(&cc, categoryConfigPath);
+    if((errorStatus = ccReader.readInto()).isValid())
+        return qxErrToRefError(ReferenceErrorType::CategoryConfig, errorStatus);
+
+    // Read pattern tally, counting each pattern towards its category's summary
+    RefBallotBox bb(RefBallotBox::Summaries);
+    RefBallotBox::Reader bbReader(&bb, patternTallyPath, &cc, RefBallotBox::Patterns);
+    if((errorStatus = bbReader.readInto()).isValid())
+        return qxErrToRefError(ReferenceErrorType::BallotBox, errorStatus);
 
-    returnBuffer = electionTransform(bb, cc.seats());
+    // Finish summaries
+    returnBuffer = bb.summaries(cc.seats());
 
     return ReferenceError();
 }
 
+/*!
+ *  @param[out] returnBuffer A list of elections, prepared with the provided data.
+ *  @param[in] binaryBallotBoxPath The path to the binary ballot box file.
+ *  @return An error object containing error details if the operation fails.
+ *
+ *  @sa electionsToBinaryOutput().
+ */
+ReferenceError electionsFromBinaryInput(QList<Election>& returnBuffer, const QString& binaryBallotBoxPath)
+{
+    // Clear return buffer
+    returnBuffer.clear();
+
+    // Read file
+    RefBinaryBox::Reader bbReader(&returnBuffer, binaryBallotBoxPath);
+    return qxErrToRefError(ReferenceErrorType::BinaryBallotBox, bbReader.readInto());
+}
+
+/*!
+ *  @param[in] elections The elections to save, which must all have the same number of ballots and none of
+ *  which may be weighted.
+ *  @param[in] binaryBallotBoxPath The path to write the binary ballot box file to.
+ *  @param[in] checksum Whether or not to append a checksum to the file.
+ *  @return An error object containing error details if the operation fails.
+ *
+ *  @sa electionsFromBinaryInput().
+ */
+ReferenceError electionsToBinaryOutput(const QList<Election>& elections, const QString& binaryBallotBoxPath, bool checksum)
+{
+    RefBinaryBox::Writer bbWriter(&elections, binaryBallotBoxPath, checksum);
+    return qxErrToRefError(ReferenceErrorType::BinaryBallotBox, bbWriter.write());
+}
+
+/*!
+ *  @param[out] returnBuffer A list of election summaries, prepared with the provided data.
+ *  @param[in] binarySummaryPath The path to the binary summary file.
+ *  @return An error object containing error details if the operation fails.
+ *
+ *  @sa summariesToBinaryOutput().
+ */
+ReferenceError summariesFromBinaryInput(QList<ElectionSummary>& returnBuffer, const QString& binarySummaryPath)
+{
+    // Clear return buffer
+    returnBuffer.clear();
+
+    // Read file
+    RefBinarySummary::Reader bsReader(&returnBuffer, binarySummaryPath);
+    return qxErrToRefError(ReferenceErrorType::BinarySummary, bsReader.readInto());
+}
+
+/*!
+ *  @param[in] summaries The summaries to save, which must all include their head-to-head preferences.
+ *  @param[in] binarySummaryPath The path to write the binary summary file to.
+ *  @param[in] checksum Whether or not to append a checksum to the file.
+ *  @return An error object containing error details if the operation fails.
+ *
+ *  @sa summariesFromBinaryInput() and ElectionSummary::hasPreferences().
+ */
+ReferenceError summariesToBinaryOutput(const QList<ElectionSummary>& summaries, const QString& binarySummaryPath, bool checksum)
+{
+    RefBinarySummary::Writer bsWriter(&summaries, binarySummaryPath, checksum);
+    return qxErrToRefError(ReferenceErrorType::BinarySummary, bsWriter.write());
+}
+
 /*!
  *  @param[out] returnBuffer A list of expected election results, filled
  *  with the provided data.
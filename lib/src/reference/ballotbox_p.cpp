@@ -1,8 +1,10 @@
 // Unit Include
 #include "ballotbox_p.h"
 
+// Standard Library Includes
+#include <algorithm>
+
 // Qx Includes
-#include <qx/core/qx-dsvtable.h>
 #include <qx/io/qx-common-io.h>
 
 // Project Includes
@@ -11,6 +13,324 @@
 namespace Star
 {
 /*! @cond */
+
+namespace
+{
+    const char CSV_DELIMITER = ',';
+    const char CSV_QUOTE = '"';
+    const QString ERR_UNTERMINATED_QUOTE = u"A quoted field was not terminated before the end of the file."_s;
+
+    bool isFieldEnd(char c) { return c == CSV_DELIMITER || c == '\n'; }
+
+    /* Parses a score field directly from its bytes. Accepts an optional surrounding pair of quotes,
+     * surrounding whitespace, and a single unsigned value from 0 to 5 (leading zeros and a leading
+     * '+' are tolerated, as they were with QString::toUInt()). A blank field is a score of 0.
+     */
+    bool parseScore(QByteArrayView field, quint8& score)
+    {
+        const char* cur = field.data();
+        const char* end = cur + field.size();
+
+        auto isSpace = [](char c){ return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f'; };
+        while(cur != end && isSpace(*cur)) cur++;
+        while(cur != end && isSpace(*(end - 1))) end--;
+
+        if(cur == end)
+        {
+            score = 0;
+            return true;
+        }
+
+        if(*cur == '+')
+            cur++;
+
+        if(cur == end)
+            return false;
+
+        unsigned value = 0;
+        for(; cur != end; cur++)
+        {
+            unsigned digit = unsigned(*cur) - '0';
+            if(digit > 9)
+                return false;
+
+            value = value * 10 + digit;
+            if(value > 5)
+                return false;
+        }
+
+        score = value;
+        return true;
+    }
+
+    // Parses the number of ballots that share a score pattern, which must be positive
+    bool parseCount(QByteArrayView field, int& count)
+    {
+        bool ok;
+        count = field.trimmed().toInt(&ok);
+        return ok && count > 0;
+    }
+
+    /* Tokenizes CSV records from a file that has been mapped into memory. Fields are returned as views
+     * directly into the mapping, so no copies are made except for the rare quoted field that contains
+     * escaped quotes, which has to be rewritten.
+     */
+    class CsvMap
+    {
+    //-Instance Variables------------------------------------------------------------------------------------
+    private:
+        QByteArrayView mData;
+        qsizetype mPos;
+        QList<QByteArray> mRewrites;
+        QString mError;
+
+    //-Constructor------------------------------------------------------------------------------------------
+    public:
+        CsvMap(QByteArrayView data) :
+            mData(data),
+            mPos(0)
+        {}
+
+    //-Instance Functions-----------------------------------------------------------------------------------
+    private:
+        QByteArray& rewrite(qsizetype fieldIdx)
+        {
+            if(mRewrites.size() <= fieldIdx)
+                mRewrites.resize(fieldIdx + 1);
+
+            QByteArray& rw = mRewrites[fieldIdx];
+            rw.resize(0);
+            return rw;
+        }
+
+    public:
+        bool hasError() const { return !mError.isEmpty(); }
+        QString errorString() const { return mError; }
+
+        // Fills fields with views of the next record and returns false at the end of input or on error
+        bool readRecord(QList<QByteArrayView>& fields)
+        {
+            if(mPos >= mData.size())
+                return false;
+
+            const char* begin = mData.data();
+            const char* end = begin + mData.size();
+            const char* cur = begin + mPos;
+            qsizetype fieldCount = 0;
+
+            forever
+            {
+                QByteArrayView field;
+
+                if(cur != end && *cur == CSV_QUOTE)
+                {
+                    // Find the closing quote, skipping escaped ones
+                    const char* start = ++cur;
+                    bool escaped = false;
+                    forever
+                    {
+                        cur = std::find(cur, end, CSV_QUOTE);
+                        if(cur == end)
+                        {
+                            mError = ERR_UNTERMINATED_QUOTE;
+                            return false;
+                        }
+
+                        if(cur + 1 != end && cur[1] == CSV_QUOTE)
+                        {
+                            escaped = true;
+                            cur += 2;
+                        }
+                        else
+                            break;
+                    }
+
+                    field = QByteArrayView(start, cur++);
+
+                    // Anything between the closing quote and the end of the field is kept as is
+                    const char* stop = std::find_if(cur, end, isFieldEnd);
+                    const char* trailEnd = (stop != cur && *(stop - 1) == '\r') ? stop - 1 : stop;
+
+                    if(escaped || trailEnd != cur)
+                    {
+                        QByteArray& rw = rewrite(fieldCount);
+                        for(const char* c = field.data(); c != field.data() + field.size(); c++)
+                        {
+                            rw.append(*c);
+                            if(*c == CSV_QUOTE)
+                                c++; // Skip the second quote of the pair
+                        }
+                        rw.append(cur, trailEnd - cur);
+                        field = rw;
+                    }
+
+                    cur = stop;
+                }
+                else
+                {
+                    const char* stop = std::find_if(cur, end, isFieldEnd);
+                    const char* fieldEnd = (stop != cur && *(stop - 1) == '\r') ? stop - 1 : stop;
+                    field = QByteArrayView(cur, fieldEnd);
+                    cur = stop;
+                }
+
+                if(fieldCount < fields.size())
+                    fields[fieldCount] = field;
+                else
+                    fields.append(field);
+                fieldCount++;
+
+                // Next field, or end of record
+                if(cur != end && *cur == CSV_DELIMITER)
+                    cur++;
+                else
+                {
+                    if(cur != end)
+                        cur++; // Newline
+                    break;
+                }
+            }
+
+            fields.resize(fieldCount);
+            mPos = cur - begin;
+            return true;
+        }
+    };
+
+    /* Tokenizes CSV records straight from a device a chunk at a time, for when a file cannot be mapped,
+     * so that only the current chunk and the fields of the current record are ever held in memory.
+     */
+    class CsvStream
+    {
+    //-Class Variables--------------------------------------------------------------------------------------
+    private:
+        static inline const qsizetype CHUNK_SIZE = 64 * 1024;
+
+    //-Instance Variables------------------------------------------------------------------------------------
+    private:
+        QIODevice* mDevice;
+        QByteArray mChunk;
+        qsizetype mPos;
+        QList<QByteArray> mFields;
+        QString mError;
+
+    //-Constructor------------------------------------------------------------------------------------------
+    public:
+        CsvStream(QIODevice* device) :
+            mDevice(device),
+            mPos(0)
+        {}
+
+    //-Instance Functions-----------------------------------------------------------------------------------
+    private:
+        bool nextChunk()
+        {
+            mChunk.resize(CHUNK_SIZE);
+            qint64 read = mDevice->read(mChunk.data(), CHUNK_SIZE);
+            if(read < 0)
+                mError = mDevice->errorString();
+
+            mChunk.resize(std::max(read, qint64(0)));
+            mPos = 0;
+            return !mChunk.isEmpty();
+        }
+
+        bool ensureData() { return mPos < mChunk.size() || nextChunk(); }
+
+        bool finishRecord(qsizetype fieldCount, QList<QByteArrayView>& fields)
+        {
+            mFields.resize(fieldCount);
+            fields.resize(fieldCount);
+            for(qsizetype i = 0; i < fieldCount; i++)
+                fields[i] = mFields.at(i);
+
+            return true;
+        }
+
+    public:
+        bool hasError() const { return !mError.isEmpty(); }
+        QString errorString() const { return mError; }
+
+        // Fills fields with views of the next record and returns false at the end of input or on error
+        bool readRecord(QList<QByteArrayView>& fields)
+        {
+            if(!ensureData())
+                return false;
+
+            qsizetype fieldCount = 0;
+            auto startField = [&]{
+                if(fieldCount < mFields.size())
+                    mFields[fieldCount].resize(0);
+                else
+                    mFields.append(QByteArray());
+                return fieldCount++;
+            };
+
+            qsizetype f = startField();
+            bool quoted = false;
+
+            while(ensureData())
+            {
+                const char* chunkBegin = mChunk.constData();
+                const char* chunkEnd = chunkBegin + mChunk.size();
+                const char* cur = chunkBegin + mPos;
+
+                if(quoted)
+                {
+                    // Take everything up to the next quote verbatim
+                    const char* q = std::find(cur, chunkEnd, CSV_QUOTE);
+                    mFields[f].append(cur, q - cur);
+                    mPos = q - chunkBegin;
+                    if(q == chunkEnd)
+                        continue;
+
+                    // Either an escaped quote or the end of the quoted section
+                    mPos++;
+                    if(ensureData() && mChunk.at(mPos) == CSV_QUOTE)
+                    {
+                        mFields[f].append(CSV_QUOTE);
+                        mPos++;
+                    }
+                    else
+                        quoted = false;
+
+                    continue;
+                }
+
+                // Take everything up to the next special character
+                const char* special = std::find_if(cur, chunkEnd, [](char c){
+                    return c == CSV_DELIMITER || c == '\n' || c == '\r' || c == CSV_QUOTE;
+                });
+                mFields[f].append(cur, special - cur);
+                mPos = special - chunkBegin;
+                if(special == chunkEnd)
+                    continue;
+
+                mPos++;
+                char c = *special;
+                if(c == '\n')
+                    return finishRecord(fieldCount, fields);
+                else if(c == CSV_DELIMITER)
+                    f = startField();
+                else if(c == CSV_QUOTE && mFields.at(f).isEmpty())
+                    quoted = true;
+                else if(c == CSV_QUOTE)
+                    mFields[f].append(CSV_QUOTE); // Stray quote in unquoted field, keep as is
+                // Carriage returns are dropped
+            }
+
+            if(quoted)
+            {
+                mError = ERR_UNTERMINATED_QUOTE;
+                return false;
+            }
+
+            // Last record without a trailing newline
+            return !hasError() && finishRecord(fieldCount, fields);
+        }
+    };
+}
+
 //===============================================================================================================
 // RefBallotBoxError
 //===============================================================================================================
@@ -39,12 +359,46 @@ QString RefBallotBoxError::deriveSecondary() const { return mString; }
 
 //-Constructor--------------------------------------------------------------------------------------------------------
 //Public:
-RefBallotBox::RefBallotBox() {}
+RefBallotBox::RefBallotBox(Mode mode) :
+    mMode(mode),
+    mBallotCount(0)
+{}
 
 //-Instance Functions-------------------------------------------------------------------------------------------------
 //Public:
 const QList<RefCategory>& RefBallotBox::categories() const { return mCategories; }
-const QList<RefBallot>& RefBallotBox::ballots() const { return mBallots; }
+qsizetype RefBallotBox::ballotCount() const { return mBallotCount; }
+
+QList<Election> RefBallotBox::elections(uint seatCount)
+{
+    /* Each builder hands over its election, so this can only be done once. Every election refers to the
+     * same voter list, while only their scores are separate.
+     */
+    QList<Election> elections;
+    elections.reserve(mElectionBuilders.size());
+
+    for(Election::Builder& eb : mElectionBuilders)
+    {
+        // Patterns have no voters of their own
+        if(!mVoters.isEmpty())
+            eb.wVoters(mVoters);
+
+        elections.append(eb.wSeatCount(seatCount).build());
+    }
+
+    return elections;
+}
+
+QList<ElectionSummary> RefBallotBox::summaries(uint seatCount)
+{
+    QList<ElectionSummary> summaries;
+    summaries.reserve(mSummaryBuilders.size());
+
+    for(ElectionSummary::Builder& sb : mSummaryBuilders)
+        summaries.append(sb.wSeatCount(seatCount).build());
+
+    return summaries;
+}
 
 //===============================================================================================================
 // RefBallotBox::Reader
@@ -52,16 +406,17 @@ const QList<RefBallot>& RefBallotBox::ballots() const { return mBallots; }
 
 //-Constructor-----------------------------------------------------------------------------------------------------
 //Protected:
-RefBallotBox::Reader::Reader(RefBallotBox* targetBox, const QString& filePath, const RefCategoryConfig* categoryConfig) :
+RefBallotBox::Reader::Reader(RefBallotBox* targetBox, const QString& filePath, const RefCategoryConfig* categoryConfig, Layout layout) :
     mTargetBox(targetBox),
     mCsvFile(filePath),
     mCategoryConfig(categoryConfig),
+    mLayout(layout),
     mExpectedFieldCount(STATIC_FIELD_COUNT + mCategoryConfig->totalCandidates())
 {}
 
 //-Instance Functions-------------------------------------------------------------------------------------------------
 //Private:
-RefBallotBoxError RefBallotBox::Reader::parseCategories(const QList<QVariant>& headingsRow)
+RefBallotBoxError RefBallotBox::Reader::parseCategories(const QList<QByteArrayView>& headingsRow, qsizetype ballotHint)
 {
     // Fill out categories
     qsizetype cIdx = STATIC_FIELD_COUNT; // Skip known headings
@@ -74,7 +429,7 @@ RefBallotBoxError RefBallotBox::Reader::parseCategories(const QList<QVariant>& h
 
         for(uint i = 0; i < ch.candidateCount; i++, cIdx++)
         {
-            QString candidateField = headingsRow[cIdx].toString().trimmed();
+            QString candidateField = QString::fromUtf8(headingsRow[cIdx]).trimmed();
             if(candidateField.isEmpty())
                 return RefBallotBoxError(RefBallotBoxError::BlankValue, 0, cIdx);
 
@@ -84,125 +439,197 @@ RefBallotBoxError RefBallotBox::Reader::parseCategories(const QList<QVariant>& h
             candidates += candidateField;
         }
 
-        // Add category to box
+        // Add category to box, along with the builder its ballots will be streamed into
+        if(mTargetBox->mMode == Summaries)
+            mTargetBox->mSummaryBuilders.emplace_back(category.name).wCandidates(candidates);
+        else
+        {
+            Election::Builder& eb = mTargetBox->mElectionBuilders.emplace_back(category.name);
+            if(candidates.size() > SPARSE_CANDIDATE_COUNT)
+                eb.wScoreLayout(Election::Sparse);
+            eb.reserve(ballotHint, candidates.size());
+            eb.wCandidates(candidates);
+
+            // Patterns are often repeated across concatenated tallies, so they're combined as well
+            if(mLayout == Patterns)
+                eb.wCollapseDuplicates(true);
+        }
         mTargetBox->mCategories.append(category);
+        mCategoryNames.append(category.name.toUtf8());
     }
 
     return RefBallotBoxError();
 }
 
-RefBallotBoxError RefBallotBox::Reader::parseBallot(const QList<QVariant>& ballotRow, qsizetype ballotNum)
+RefBallotBoxError RefBallotBox::Reader::parseBallot(const QList<QByteArrayView>& ballotRow, qsizetype rowNum)
 {
     // Ignore lines with all empty fields
-    bool allEmpty = true;
-    for(const QVariant& field : ballotRow)
-    {
-        if(!field.toString().isEmpty())
-        {
-            allEmpty = false;
-            break;
-        }
-    }
-
+    bool allEmpty = std::all_of(ballotRow.cbegin(), ballotRow.cend(), [](QByteArrayView field){ return field.isEmpty(); });
     if(allEmpty)
         return RefBallotBoxError();
 
-    // Read submission date
-    QDate submitted = QDate::fromString(ballotRow[SUBMISSION_DATE_INDEX].toString(), "d-MMM-yy").addYears(100);
-//    Since this value isn't actually used as part of the election, it doesn't really matter if this is valid
-//    if(!submitted.isValid())
-//        return Qx::GenericError(ERROR_TEMPLATE).setSecondaryInfo(ERR_INVALID_DATE);
+    // Ensure the field count is correct
+    if(ballotRow.size() != mExpectedFieldCount)
+        return RefBallotBoxError(RefBallotBoxError::InvalidColumnCount, ballotRow.size(), mExpectedFieldCount);
 
-    // Read voter name
-    QString voterName = ballotRow[MEMBER_NAME_INDEX].toString();
+    // The submission date isn't part of the election, so it isn't decoded
+    QByteArrayView voterName = ballotRow[MEMBER_NAME_INDEX];
     if(voterName.isEmpty())
-        return RefBallotBoxError(RefBallotBoxError::BlankValue, ballotNum, MEMBER_NAME_INDEX);
-
-    // Create ballot with existing info
-    RefBallot ballot{.voter = voterName, .submissionDate = submitted, .votes = {}};
-
-    // Read votes by category
-    qsizetype cIdx = STATIC_FIELD_COUNT; // Skip known headings
+        return RefBallotBoxError(RefBallotBoxError::BlankValue, rowNum, MEMBER_NAME_INDEX);
 
-    for(const RefCategoryHeader& ch : mCategoryConfig->headers())
+    /* Read all scores into the packed row buffer before handing any to the builders, so that a bad
+     * ballot doesn't leave only some of the categories with it
+     */
+    quint8* rowScores = mRowScores.data();
+    for(qsizetype cIdx = STATIC_FIELD_COUNT; cIdx < mExpectedFieldCount; cIdx++)
     {
-        QList<int> categoryVotes;
+        if(!parseScore(ballotRow[cIdx], *rowScores++))
+            return RefBallotBoxError(RefBallotBoxError::InvalidVote, rowNum, cIdx);
+    }
 
-        for(uint i = 0; i < ch.candidateCount; i++, cIdx++)
-        {
-            QString voteField = ballotRow[cIdx].toString().trimmed();
+    // Create standard voter once for all categories (For now, just set the anonymous name to "Voter N")
+    qsizetype ballotIdx = mTargetBox->mBallotCount++;
+    bool summarize = mTargetBox->mMode == Summaries;
+    if(!summarize)
+    {
+        mTargetBox->mVoters.append(Election::Voter{
+            .name = QString::fromUtf8(voterName),
+            .anonymousName = ANONYMOUS_NAME_TEMPLATE.arg(ballotIdx)
+        });
+    }
 
-            // If field is blank, treat it as a 0
-            if(voteField.isEmpty())
-            {
-                categoryVotes.append(0);
-                continue;
-            }
+    // Add each category's slice of the scores to its election or summary
+    std::span<const quint8> remainingScores(mRowScores.constData(), mRowScores.size());
 
-            // Get value from field
-            bool validValue;
-            int vote = voteField.toUInt(&validValue); // Stored as int, but should be a uint
+    for(qsizetype catIdx = 0; catIdx < mTargetBox->mCategories.size(); catIdx++)
+    {
+        qsizetype candidateCount = mTargetBox->mCategories.at(catIdx).candidates.size();
+        std::span<const quint8> categoryScores = remainingScores.first(candidateCount);
+        if(summarize)
+            mTargetBox->mSummaryBuilders[catIdx].wBallot(categoryScores);
+        else
+            mTargetBox->mElectionBuilders[catIdx].wBallot(categoryScores);
+        remainingScores = remainingScores.subspan(candidateCount);
+    }
 
-            if(!validValue || vote > 5)
-                return RefBallotBoxError(RefBallotBoxError::InvalidVote, ballotNum, cIdx);
+    return RefBallotBoxError();
+}
 
-            categoryVotes.append(vote);
-        }
+RefBallotBoxError RefBallotBox::Reader::parsePattern(const QList<QByteArrayView>& patternRow, qsizetype rowNum)
+{
+    // Ignore lines with all empty fields
+    bool allEmpty = std::all_of(patternRow.cbegin(), patternRow.cend(), [](QByteArrayView field){ return field.isEmpty(); });
+    if(allEmpty)
+        return RefBallotBoxError();
 
-        ballot.votes.append(categoryVotes);
+    // Determine the category, which dictates the length of the row
+    QByteArrayView categoryName = patternRow[CATEGORY_NAME_INDEX].trimmed();
+    auto catItr = std::find_if(mCategoryNames.cbegin(), mCategoryNames.cend(), [&](const QByteArray& name){ return name == categoryName; });
+    if(catItr == mCategoryNames.cend())
+        return RefBallotBoxError(RefBallotBoxError::UnknownCategory, rowNum, CATEGORY_NAME_INDEX);
+
+    qsizetype catIdx = catItr - mCategoryNames.cbegin();
+    qsizetype candidateCount = mTargetBox->mCategories.at(catIdx).candidates.size();
+    qsizetype expectedFieldCount = STATIC_FIELD_COUNT + candidateCount;
+    if(patternRow.size() != expectedFieldCount)
+        return RefBallotBoxError(RefBallotBoxError::InvalidColumnCount, patternRow.size(), expectedFieldCount);
+
+    int count;
+    if(!parseCount(patternRow[PATTERN_COUNT_INDEX], count))
+        return RefBallotBoxError(RefBallotBoxError::InvalidCount, rowNum, PATTERN_COUNT_INDEX);
+
+    // Read the pattern, then count it once with the weight of every ballot that shares it
+    quint8* rowScores = mRowScores.data();
+    for(qsizetype cIdx = STATIC_FIELD_COUNT; cIdx < expectedFieldCount; cIdx++)
+    {
+        if(!parseScore(patternRow[cIdx], *rowScores++))
+            return RefBallotBoxError(RefBallotBoxError::InvalidVote, rowNum, cIdx);
     }
 
-    // Add ballot to box
-    mTargetBox->mBallots.append(ballot);
+    std::span<const quint8> pattern(mRowScores.constData(), candidateCount);
+    if(mTargetBox->mMode == Summaries)
+        mTargetBox->mSummaryBuilders[catIdx].wBallot(pattern, count);
+    else
+        mTargetBox->mElectionBuilders[catIdx].wBallot(pattern, count);
 
     return RefBallotBoxError();
 }
 
-//Public:
-RefBallotBoxError RefBallotBox::Reader::readInto()
+template<class CsvSource>
+RefBallotBoxError RefBallotBox::Reader::readRecords(CsvSource& csv, qsizetype ballotHint)
 {
     // Error tracking
     RefBallotBoxError errorStatus;
 
-    // Quickly check if file is empty
-    if(Qx::fileIsEmpty(mCsvFile))
-        return RefBallotBoxError(RefBallotBoxError::Empty);
-
-    // Read whole CSV into memory as raw data
-    QByteArray csv;
-    Qx::IoOpReport readReport = Qx::readBytesFromFile(csv, mCsvFile);
-    if(readReport.isFailure())
-        return RefBallotBoxError(RefBallotBoxError::IoError, readReport.outcomeInfo());
+    // Fields of the current record, reused throughout
+    QList<QByteArrayView> row;
+    row.reserve(mExpectedFieldCount);
+    mRowScores.resize(mExpectedFieldCount - STATIC_FIELD_COUNT);
 
-    // Parse into DsvTable
-    Qx::DsvParseError dsvError;
-    Qx::DsvTable csvTable = Qx::DsvTable::fromDsv(csv, ',', '"', &dsvError);
-    if(dsvError.error() != Qx::DsvParseError::NoError)
-        return RefBallotBoxError(RefBallotBoxError::IoError, dsvError.errorString());
-
-    // Ensure the minimum amount of rows are present
-    if(csvTable.rowCount() < 3)
-        return RefBallotBoxError(RefBallotBoxError::InvalidRowCount);
-
-    // Ensure the column count is correct
-    if(csvTable.columnCount() != mExpectedFieldCount)
-        return RefBallotBoxError(RefBallotBoxError::InvalidColumnCount, csvTable.columnCount(), mExpectedFieldCount);
+    // Process headings
+    if(!csv.readRecord(row))
+        return csv.hasError() ? RefBallotBoxError(RefBallotBoxError::IoError, csv.errorString()) :
+                                RefBallotBoxError(RefBallotBoxError::InvalidRowCount);
 
-    // Separate headings from ballot rows
-    QList<QVariant> headingRow = csvTable.takeFirstRow();
+    if(row.size() != mExpectedFieldCount)
+        return RefBallotBoxError(RefBallotBoxError::InvalidColumnCount, row.size(), mExpectedFieldCount);
 
-    // Process headings
-    if((errorStatus = parseCategories(headingRow)).isValid())
+    if((errorStatus = parseCategories(row, ballotHint)).isValid())
         return errorStatus;
 
-    // Process ballots
-    for(qsizetype i = 0; i < csvTable.rowCount(); i++)
+    if(mTargetBox->mMode == Elections && mLayout == Ballots)
+        mTargetBox->mVoters.reserve(ballotHint);
+
+    // Process ballots or patterns as they're read
+    qsizetype rowNum = 0;
+    for(; csv.readRecord(row); rowNum++)
     {
-        if((errorStatus = parseBallot(csvTable.rowAt(i), i)).isValid())
+        errorStatus = mLayout == Patterns ? parsePattern(row, rowNum) : parseBallot(row, rowNum);
+        if(errorStatus.isValid())
             return errorStatus;
     }
 
+    if(csv.hasError())
+        return RefBallotBoxError(RefBallotBoxError::IoError, csv.errorString());
+
+    // Ensure the minimum amount of rows were present, though a single pattern can stand for any number of ballots
+    if(rowNum < (mLayout == Patterns ? 1 : 2))
+        return RefBallotBoxError(RefBallotBoxError::InvalidRowCount);
+
     return errorStatus;
 }
+
+//Public:
+RefBallotBoxError RefBallotBox::Reader::readInto()
+{
+    // Quickly check if file is empty
+    if(Qx::fileIsEmpty(mCsvFile))
+        return RefBallotBoxError(RefBallotBoxError::Empty);
+
+    if(!mCsvFile.open(QIODevice::ReadOnly))
+        return RefBallotBoxError(RefBallotBoxError::IoError, mCsvFile.errorString());
+
+    // Scan the file in place if it can be mapped, otherwise fall back to streaming it
+    if(uchar* mapping = mCsvFile.map(0, mCsvFile.size()))
+    {
+        /* Every line past the headings is close enough to a ballot for sizing the builders ahead of time.
+         * Counting them is far cheaper than the reallocation it avoids, though summaries need no such room,
+         * and neither do patterns, which are spread across categories and are few to begin with.
+         */
+        QByteArrayView contents(mapping, mCsvFile.size());
+        bool sizeHint = mTargetBox->mMode == Elections && mLayout == Ballots;
+        qsizetype lineCount = sizeHint ? std::count(contents.cbegin(), contents.cend(), '\n') : 0;
+
+        CsvMap csv(contents);
+        RefBallotBoxError errorStatus = readRecords(csv, std::max(lineCount - 1, qsizetype(0)));
+        mCsvFile.unmap(mapping);
+        return errorStatus;
+    }
+    else
+    {
+        CsvStream csv(&mCsvFile);
+        return readRecords(csv, 0);
+    }
+}
 /*! @endcond */
 }
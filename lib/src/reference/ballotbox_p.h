@@ -4,12 +4,16 @@
 // Qt Includes
 #include <QString>
 #include <QList>
-#include <QDate>
+#include <QByteArrayView>
 #include <QFile>
 
 // Qx Includes
 #include <qx/core/qx-abstracterror.h>
 
+// Project Includes
+#include "star/election.h"
+#include "star/electionsummary.h"
+
 namespace Star
 {
 /*! @cond */
@@ -23,13 +27,6 @@ struct RefCategory
     QStringList candidates;
 };
 
-struct RefBallot
-{
-    QString voter;
-    QDate submissionDate;
-    QList<QList<int>> votes;
-};
-
 class QX_ERROR_TYPE(RefBallotBoxError, "Star::RefBallotBoxError", 1150)
 {
     friend class RefBallotBox;
@@ -45,6 +42,8 @@ public:
         BlankValue,
         InvalidVote,
         DuplicateCandidate,
+        UnknownCategory,
+        InvalidCount,
         IoError
     };
 
@@ -60,6 +59,8 @@ private:
         {BlankValue, u"A field expected to have a value was blank (r: %1, c: %2)."_s},
         {InvalidVote, u"A vote value was not a valid unsigned integer between 0 and 5 (r: %1, c: %2)."_s},
         {DuplicateCandidate, u"The ballot box contained duplicate candidates within the same category."_s},
+        {UnknownCategory, u"A pattern was given for a category that is not part of the category configuration (r: %1, c: %2)."_s},
+        {InvalidCount, u"A ballot count was not a valid integer greater than 0 (r: %1, c: %2)."_s},
         {IoError, u"IO Error: %1"_s}
     };
 
@@ -108,19 +109,34 @@ class RefBallotBox
 public:
     class Reader;
 
+//-Class Enums------------------------------------------------------------------------------------------------------
+public:
+    enum Mode { Elections, Summaries };
+    enum Layout { Ballots, Patterns };
+
 //-Instance Variables--------------------------------------------------------------------------------------------------
 private:
+    Mode mMode;
     QList<RefCategory> mCategories;
-    QList<RefBallot> mBallots;
+    qsizetype mBallotCount;
+
+    // Elections mode
+    QList<Election::Voter> mVoters; // Shared by every category
+    QList<Election::Builder> mElectionBuilders; // One per category, holding only its scores
+
+    // Summaries mode
+    QList<ElectionSummary::Builder> mSummaryBuilders; // One per category, ballots are discarded once counted
 
 //-Constructor--------------------------------------------------------------------------------------------------------
 public:
-    RefBallotBox();
+    RefBallotBox(Mode mode = Elections);
 
 //-Instance Functions-------------------------------------------------------------------------------------------------
 public:
     const QList<RefCategory>& categories() const;
-    const QList<RefBallot>& ballots() const;
+    qsizetype ballotCount() const;
+    QList<Election> elections(uint seatCount);
+    QList<ElectionSummary> summaries(uint seatCount);
 };
 
 class RefBallotBox::Reader
@@ -131,22 +147,36 @@ private:
     static const int STATIC_FIELD_COUNT = 2;
     static const int SUBMISSION_DATE_INDEX = 0;
     static const int MEMBER_NAME_INDEX = 1;
+    static const int CATEGORY_NAME_INDEX = 0;
+    static const int PATTERN_COUNT_INDEX = 1;
+
+    // Voters
+    static inline const QString ANONYMOUS_NAME_TEMPLATE = QStringLiteral("Voter %1");
+
+    // Categories with more candidates than this are mostly write-ins, which each voter only scores a few of
+    static const int SPARSE_CANDIDATE_COUNT = 64;
 
 //-Instance Variables--------------------------------------------------------------------------------------------------
 private:
     RefBallotBox* mTargetBox;
     QFile mCsvFile;
     const RefCategoryConfig* mCategoryConfig;
+    Layout mLayout;
     qsizetype mExpectedFieldCount;
+    QList<quint8> mRowScores; // All categories, packed
+    QList<QByteArray> mCategoryNames; // UTF-8, for matching pattern rows without decoding them
 
 //-Constructor--------------------------------------------------------------------------------------------------------
 public:
-    Reader(RefBallotBox* targetBox, const QString& filePath, const RefCategoryConfig* categoryConfig);
+    Reader(RefBallotBox* targetBox, const QString& filePath, const RefCategoryConfig* categoryConfig, Layout layout = Ballots);
 
 //-Instance Functions-------------------------------------------------------------------------------------------------
 private:
-    RefBallotBoxError parseCategories(const QList<QVariant>& headingsRow);
-    RefBallotBoxError parseBallot(const QList<QVariant>& ballotRow, qsizetype ballotNum);
+    RefBallotBoxError parseCategories(const QList<QByteArrayView>& headingsRow, qsizetype ballotHint);
+    RefBallotBoxError parseBallot(const QList<QByteArrayView>& ballotRow, qsizetype rowNum);
+    RefBallotBoxError parsePattern(const QList<QByteArrayView>& patternRow, qsizetype rowNum);
+    template<class CsvSource>
+    RefBallotBoxError readRecords(CsvSource& csv, qsizetype ballotHint);
 
 public:
     RefBallotBoxError readInto();
@@ -0,0 +1,293 @@
+// Unit Include
+#include "binarybox_p.h"
+
+// Standard Library Includes
+#include <algorithm>
+
+// Qt Includes
+#include <QSaveFile>
+
+// Project Includes
+#include "bytestream_p.h"
+
+namespace Star
+{
+/*! @cond */
+
+//===============================================================================================================
+// RefBinaryBoxError
+//===============================================================================================================
+
+//-Constructor--------------------------------------------------------------------
+RefBinaryBoxError::RefBinaryBoxError(Type t) :
+    mType(t),
+    mString(ERR_STRINGS.value(t))
+{}
+
+//-Instance Functions-------------------------------------------------------------
+//Public:
+bool RefBinaryBoxError::isValid() const { return mType != NoError; }
+RefBinaryBoxError::Type RefBinaryBoxError::type() const { return mType; }
+QString RefBinaryBoxError::string() const { return mString; }
+
+//Private:
+Qx::Severity RefBinaryBoxError::deriveSeverity() const { return Qx::Critical; }
+quint32 RefBinaryBoxError::deriveValue() const { return mType; }
+QString RefBinaryBoxError::derivePrimary() const { return MAIN_ERR_MSG; }
+QString RefBinaryBoxError::deriveSecondary() const { return mString; }
+
+//===============================================================================================================
+// RefBinaryBox::Reader
+//===============================================================================================================
+
+//-Constructor-----------------------------------------------------------------------------------------------------
+//Public:
+RefBinaryBox::Reader::Reader(QList<Election>* targetList, const QString& filePath) :
+    mTargetList(targetList),
+    mFile(filePath)
+{}
+
+//-Instance Functions-------------------------------------------------------------------------------------------------
+//Private:
+RefBinaryBoxError RefBinaryBox::Reader::parse(QByteArrayView data)
+{
+    ByteReader reader(data);
+
+    // Header
+    if(reader.take(MAGIC.size()) != MAGIC)
+        return RefBinaryBoxError(RefBinaryBoxError::InvalidFormat);
+
+    quint16 version = reader.read<quint16>();
+    if(reader.hasOverrun())
+        return RefBinaryBoxError(RefBinaryBoxError::Truncated);
+    if(version != VERSION)
+        return RefBinaryBoxError(RefBinaryBoxError::UnsupportedVersion, version);
+
+    quint16 flags = reader.read<quint16>();
+    quint32 categoryCount = reader.read<quint32>();
+    quint64 ballotCount = reader.read<quint64>();
+    if(reader.hasOverrun())
+        return RefBinaryBoxError(RefBinaryBoxError::Truncated);
+
+    // Verify checksum before trusting anything else
+    if(flags & FLAG_CHECKSUM)
+    {
+        qsizetype checksumSize = QCryptographicHash::hashLength(REF_CHECKSUM_ALGORITHM);
+        if(data.size() < HEADER_SIZE + checksumSize)
+            return RefBinaryBoxError(RefBinaryBoxError::Truncated);
+
+        QByteArrayView contents = data.first(data.size() - checksumSize);
+        QByteArrayView checksum = data.last(checksumSize);
+        if(QCryptographicHash::hash(contents, REF_CHECKSUM_ALGORITHM) != checksum)
+            return RefBinaryBoxError(RefBinaryBoxError::ChecksumMismatch);
+    }
+
+    // Category table
+    struct Category
+    {
+        QString name;
+        quint32 seats;
+        QStringList candidates;
+    };
+    QList<Category> categories;
+
+    for(quint32 c = 0; c < categoryCount && !reader.hasOverrun(); c++)
+    {
+        Category category{.name = reader.readString(), .seats = reader.read<quint32>(), .candidates = {}};
+        quint32 candidateCount = reader.read<quint32>();
+        for(quint32 n = 0; n < candidateCount && !reader.hasOverrun(); n++)
+            category.candidates.append(reader.readString());
+
+        categories.append(category);
+    }
+
+    reader.align(SCORE_ALIGNMENT);
+    if(reader.hasOverrun())
+        return RefBinaryBoxError(RefBinaryBoxError::Truncated);
+
+    // Ensure the score tables are actually present before allocating anything based on the ballot count
+    quint64 totalCandidates = 0;
+    for(const Category& category : std::as_const(categories))
+        totalCandidates += category.candidates.size();
+
+    quint64 remaining = data.size() - reader.pos();
+    if(totalCandidates != 0 && ballotCount > remaining / totalCandidates)
+        return RefBinaryBoxError(RefBinaryBoxError::Truncated);
+
+    // Voter names aren't stored, so the same list of anonymous voters is shared by every election
+    QList<Election::Voter> voters;
+    voters.reserve(ballotCount);
+    for(quint64 v = 0; v < ballotCount; v++)
+        voters.append(Election::Voter{.name = QString(), .anonymousName = ANONYMOUS_NAME_TEMPLATE.arg(v)});
+
+    // Score tables, which are handed to the builders as-is
+    for(const Category& category : std::as_const(categories))
+    {
+        QByteArrayView table = reader.take(category.candidates.size() * qsizetype(ballotCount));
+        if(reader.hasOverrun())
+            return RefBinaryBoxError(RefBinaryBoxError::Truncated);
+
+        std::span<const quint8> scores(reinterpret_cast<const quint8*>(table.data()), table.size());
+
+        Election::Builder eb(category.name);
+        eb.wSeatCount(category.seats);
+        eb.wBallots(voters, category.candidates, scores);
+        mTargetList->append(eb.build());
+    }
+
+    return RefBinaryBoxError();
+}
+
+//Public:
+RefBinaryBoxError RefBinaryBox::Reader::readInto()
+{
+    // Clear return buffer
+    mTargetList->clear();
+
+    if(!mFile.open(QIODevice::ReadOnly))
+        return RefBinaryBoxError(RefBinaryBoxError::IoError, mFile.errorString());
+
+    if(mFile.size() < HEADER_SIZE)
+        return RefBinaryBoxError(RefBinaryBoxError::Truncated);
+
+    // Parse the file in place if it can be mapped, otherwise read it in its entirety
+    if(uchar* mapping = mFile.map(0, mFile.size()))
+    {
+        RefBinaryBoxError errorStatus = parse(QByteArrayView(mapping, mFile.size()));
+        mFile.unmap(mapping);
+        return errorStatus;
+    }
+    else
+    {
+        QByteArray contents = mFile.readAll();
+        if(mFile.error() != QFileDevice::NoError)
+            return RefBinaryBoxError(RefBinaryBoxError::IoError, mFile.errorString());
+
+        return parse(contents);
+    }
+}
+
+//===============================================================================================================
+// RefBinaryBox::Writer
+//===============================================================================================================
+
+//-Constructor-----------------------------------------------------------------------------------------------------
+//Public:
+RefBinaryBox::Writer::Writer(const QList<Election>* sourceList, const QString& filePath, bool checksum) :
+    mSourceList(sourceList),
+    mFilePath(filePath),
+    mChecksum(checksum)
+{}
+
+//-Class Functions----------------------------------------------------------------------------------------------------
+//Private:
+void RefBinaryBox::Writer::expandPlanes(QByteArray& buffer, std::span<const quint64> planes, qsizetype ballotCount)
+{
+    // Unpack a whole group of ballots at a time instead of looking up each score individually
+    buffer.resize(ballotCount);
+    char* scores = buffer.data();
+    for(qsizetype groupStart = 0; groupStart < ballotCount; groupStart += PLANE_WIDTH)
+    {
+        const quint64* group = planes.data() + groupStart / PLANE_WIDTH * PLANE_COUNT;
+        qsizetype groupEnd = std::min(groupStart + PLANE_WIDTH, ballotCount);
+        for(qsizetype b = groupStart; b < groupEnd; b++)
+        {
+            int shift = b % PLANE_WIDTH;
+            quint8 score = 0;
+            for(int p = 0; p < PLANE_COUNT; p++)
+                score |= quint8(((group[p] >> shift) & 1) << p);
+            scores[b] = char(score);
+        }
+    }
+}
+
+void RefBinaryBox::Writer::expandSparse(QByteArray& buffer, const Election& election)
+{
+    // Scatter every nonzero score into the election's entire table at once, visiting each ballot only once
+    qsizetype ballotCount = election.ballotCount();
+    buffer.fill(0, election.candidateCount() * ballotCount);
+    char* table = buffer.data();
+    for(qsizetype b = 0; b < ballotCount; b++)
+        for(const Election::SparseScore& entry : election.sparseScores(b))
+            table[entry.candidateId * ballotCount + b] = char(entry.score);
+}
+
+//-Instance Functions-------------------------------------------------------------------------------------------------
+//Public:
+RefBinaryBoxError RefBinaryBox::Writer::write()
+{
+    // All elections must come from the same set of ballots, each of which is a single voter
+    qsizetype ballotCount = mSourceList->isEmpty() ? 0 : mSourceList->first().ballotCount();
+    for(const Election& election : *mSourceList)
+    {
+        if(election.ballotCount() != ballotCount)
+            return RefBinaryBoxError(RefBinaryBoxError::InconsistentBallotCount);
+        if(election.isWeighted())
+            return RefBinaryBoxError(RefBinaryBoxError::WeightedBallots);
+    }
+
+    // Write to a temporary file that only replaces the target once complete
+    QSaveFile file(mFilePath);
+    if(!file.open(QIODevice::WriteOnly))
+        return RefBinaryBoxError(RefBinaryBoxError::IoError, file.errorString());
+
+    ByteWriter writer(&file, mChecksum);
+
+    // Header
+    writer.write(MAGIC);
+    writer.write(VERSION);
+    writer.write(mChecksum ? FLAG_CHECKSUM : quint16(0));
+    writer.write(quint32(mSourceList->size()));
+    writer.write(quint64(ballotCount));
+
+    // Category table
+    for(const Election& election : *mSourceList)
+    {
+        writer.writeString(election.name());
+        writer.write(quint32(election.seatCount()));
+        writer.write(quint32(election.candidateCount()));
+        for(const QString& candidate : election.candidates())
+            writer.writeString(candidate);
+    }
+
+    // Score tables, which are already laid out candidate-major within each election unless stored as bit planes or sparsely
+    writer.align(SCORE_ALIGNMENT);
+    QByteArray expanded;
+    for(const Election& election : *mSourceList)
+    {
+        switch(election.scoreLayout())
+        {
+            case Election::Bytes:
+                for(int id = 0; id < election.candidateCount(); id++)
+                {
+                    std::span<const quint8> scores = election.scores(id);
+                    writer.write(QByteArrayView(reinterpret_cast<const char*>(scores.data()), scores.size()));
+                }
+                break;
+
+            case Election::BitPlanes:
+                for(int id = 0; id < election.candidateCount(); id++)
+                {
+                    expandPlanes(expanded, election.scorePlanes(id), ballotCount);
+                    writer.write(expanded);
+                }
+                break;
+
+            case Election::Sparse:
+                expandSparse(expanded, election);
+                writer.write(expanded);
+                break;
+        }
+    }
+
+    // Checksum of everything prior
+    if(mChecksum)
+        writer.write(writer.checksum());
+
+    if(writer.hasFailed() || !file.commit())
+        return RefBinaryBoxError(RefBinaryBoxError::IoError, file.errorString());
+
+    return RefBinaryBoxError();
+}
+/*! @endcond */
+}
@@ -0,0 +1,149 @@
+#ifndef BINARYBOX_P_H
+#define BINARYBOX_P_H
+
+// Qt Includes
+#include <QString>
+#include <QList>
+#include <QFile>
+
+// Qx Includes
+#include <qx/core/qx-abstracterror.h>
+
+// Project Includes
+#include "star/election.h"
+
+namespace Star
+{
+/*! @cond */
+
+class QX_ERROR_TYPE(RefBinaryBoxError, "Star::RefBinaryBoxError", 1153)
+{
+    friend class RefBinaryBox;
+//-Class Enums-------------------------------------------------------------
+public:
+    enum Type
+    {
+        NoError,
+        InvalidFormat,
+        UnsupportedVersion,
+        Truncated,
+        ChecksumMismatch,
+        InconsistentBallotCount,
+        WeightedBallots,
+        IoError
+    };
+
+//-Class Variables-------------------------------------------------------------
+private:
+    static inline const QString MAIN_ERR_MSG = u"Error processing the binary ballot box."_s;
+    static inline const QHash<Type, QString> ERR_STRINGS{
+        {NoError, u""_s},
+        {InvalidFormat, u"The provided file is not a binary ballot box."_s},
+        {UnsupportedVersion, u"The binary ballot box is of an unsupported version (%1)."_s},
+        {Truncated, u"The binary ballot box ended unexpectedly."_s},
+        {ChecksumMismatch, u"The binary ballot box checksum does not match its contents."_s},
+        {InconsistentBallotCount, u"All elections in a binary ballot box must have the same number of ballots."_s},
+        {WeightedBallots, u"Elections with weighted ballots cannot be saved as a binary ballot box."_s},
+        {IoError, u"IO Error: %1"_s}
+    };
+
+//-Instance Variables-------------------------------------------------------------
+private:
+    Type mType;
+    QString mString;
+
+//-Constructor-------------------------------------------------------------
+private:
+    RefBinaryBoxError(Type t = NoError);
+
+    template<typename Arg>
+        requires std::same_as<Arg, QString> || std::integral<Arg>
+    RefBinaryBoxError(Type t, Arg arg) :
+        RefBinaryBoxError(t)
+    {
+        mString = mString.arg(arg);
+    }
+
+//-Instance Functions-------------------------------------------------------------
+public:
+    bool isValid() const;
+    Type type() const;
+    QString string() const;
+
+private:
+    Qx::Severity deriveSeverity() const override;
+    quint32 deriveValue() const override;
+    QString derivePrimary() const override;
+    QString deriveSecondary() const override;
+};
+
+class RefBinaryBox
+{
+//-Inner Classes----------------------------------------------------------------------------------------------------
+public:
+    class Reader;
+    class Writer;
+
+//-Class Variables--------------------------------------------------------------------------------------------------
+private:
+    // Layout
+    static inline const QByteArray MAGIC = QByteArrayLiteral("STARBBOX");
+    static const quint16 VERSION = 1;
+    static const quint16 FLAG_CHECKSUM = 0x0001;
+    static const qsizetype HEADER_SIZE = 24;
+    static const qsizetype SCORE_ALIGNMENT = 8;
+
+    // Voters
+    static inline const QString ANONYMOUS_NAME_TEMPLATE = QStringLiteral("Voter %1");
+};
+
+class RefBinaryBox::Reader
+{
+//-Instance Variables--------------------------------------------------------------------------------------------------
+private:
+    QList<Election>* mTargetList;
+    QFile mFile;
+
+//-Constructor--------------------------------------------------------------------------------------------------------
+public:
+    Reader(QList<Election>* targetList, const QString& filePath);
+
+//-Instance Functions-------------------------------------------------------------------------------------------------
+private:
+    RefBinaryBoxError parse(QByteArrayView data);
+
+public:
+    RefBinaryBoxError readInto();
+};
+
+class RefBinaryBox::Writer
+{
+//-Class Variables--------------------------------------------------------------------------------------------------
+private:
+    // Shape of Election::scorePlanes()
+    static const qsizetype PLANE_WIDTH = 64;
+    static const int PLANE_COUNT = 3;
+
+//-Instance Variables--------------------------------------------------------------------------------------------------
+private:
+    const QList<Election>* mSourceList;
+    QString mFilePath;
+    bool mChecksum;
+
+//-Constructor--------------------------------------------------------------------------------------------------------
+public:
+    Writer(const QList<Election>* sourceList, const QString& filePath, bool checksum);
+
+//-Class Functions----------------------------------------------------------------------------------------------------
+private:
+    static void expandPlanes(QByteArray& buffer, std::span<const quint64> planes, qsizetype ballotCount);
+    static void expandSparse(QByteArray& buffer, const Election& election);
+
+//-Instance Functions-------------------------------------------------------------------------------------------------
+public:
+    RefBinaryBoxError write();
+};
+/*! @endcond */
+}
+
+#endif // BINARYBOX_P_H
@@ -0,0 +1,219 @@
+// Unit Include
+#include "binarysummary_p.h"
+
+// Qt Includes
+#include <QSaveFile>
+#include <QSet>
+
+// Project Includes
+#include "bytestream_p.h"
+
+namespace Star
+{
+/*! @cond */
+
+//===============================================================================================================
+// RefBinarySummaryError
+//===============================================================================================================
+
+//-Constructor--------------------------------------------------------------------
+RefBinarySummaryError::RefBinarySummaryError(Type t) :
+    mType(t),
+    mString(ERR_STRINGS.value(t))
+{}
+
+//-Instance Functions-------------------------------------------------------------
+//Public:
+bool RefBinarySummaryError::isValid() const { return mType != NoError; }
+RefBinarySummaryError::Type RefBinarySummaryError::type() const { return mType; }
+QString RefBinarySummaryError::string() const { return mString; }
+
+//Private:
+Qx::Severity RefBinarySummaryError::deriveSeverity() const { return Qx::Critical; }
+quint32 RefBinarySummaryError::deriveValue() const { return mType; }
+QString RefBinarySummaryError::derivePrimary() const { return MAIN_ERR_MSG; }
+QString RefBinarySummaryError::deriveSecondary() const { return mString; }
+
+//===============================================================================================================
+// RefBinarySummary::Reader
+//===============================================================================================================
+
+//-Constructor-----------------------------------------------------------------------------------------------------
+//Public:
+RefBinarySummary::Reader::Reader(QList<ElectionSummary>* targetList, const QString& filePath) :
+    mTargetList(targetList),
+    mFile(filePath)
+{}
+
+//-Instance Functions-------------------------------------------------------------------------------------------------
+//Private:
+RefBinarySummaryError RefBinarySummary::Reader::parse(QByteArrayView data)
+{
+    ByteReader reader(data);
+
+    // Header
+    if(reader.take(MAGIC.size()) != MAGIC)
+        return RefBinarySummaryError(RefBinarySummaryError::InvalidFormat);
+
+    quint16 version = reader.read<quint16>();
+    if(reader.hasOverrun())
+        return RefBinarySummaryError(RefBinarySummaryError::Truncated);
+    if(version != VERSION)
+        return RefBinarySummaryError(RefBinarySummaryError::UnsupportedVersion, version);
+
+    quint16 flags = reader.read<quint16>();
+    quint32 categoryCount = reader.read<quint32>();
+    if(reader.hasOverrun())
+        return RefBinarySummaryError(RefBinarySummaryError::Truncated);
+
+    // Verify checksum before trusting anything else
+    if(flags & FLAG_CHECKSUM)
+    {
+        qsizetype checksumSize = QCryptographicHash::hashLength(REF_CHECKSUM_ALGORITHM);
+        if(data.size() < HEADER_SIZE + checksumSize)
+            return RefBinarySummaryError(RefBinarySummaryError::Truncated);
+
+        QByteArrayView contents = data.first(data.size() - checksumSize);
+        QByteArrayView checksum = data.last(checksumSize);
+        if(QCryptographicHash::hash(contents, REF_CHECKSUM_ALGORITHM) != checksum)
+            return RefBinarySummaryError(RefBinarySummaryError::ChecksumMismatch);
+    }
+
+    // Categories, each of which is a complete tally
+    QList<Election::ScoreStatistics> statistics;
+    QList<int> preferences;
+
+    for(quint32 c = 0; c < categoryCount; c++)
+    {
+        QString name = reader.readString();
+        quint32 seats = reader.read<quint32>();
+        quint64 ballotCount = reader.read<quint64>();
+        quint32 candidateCount = reader.read<quint32>();
+
+        QStringList candidates;
+        QSet<QString> seen;
+        for(quint32 n = 0; n < candidateCount && !reader.hasOverrun(); n++)
+        {
+            QString candidate = reader.readString();
+            if(seen.contains(candidate))
+                return RefBinarySummaryError(RefBinarySummaryError::InvalidFormat);
+
+            seen.insert(candidate);
+            candidates.append(candidate);
+        }
+
+        if(reader.hasOverrun())
+            return RefBinarySummaryError(RefBinarySummaryError::Truncated);
+
+        // Ensure the tally is actually present before allocating anything based on the candidate count
+        quint64 tallySize = quint64(candidateCount) * (SCORE_COUNT + candidateCount) * sizeof(quint32);
+        if(tallySize > quint64(data.size() - reader.pos()))
+            return RefBinarySummaryError(RefBinarySummaryError::Truncated);
+
+        statistics.resize(candidateCount);
+        for(Election::ScoreStatistics& stats : statistics)
+            for(int& count : stats.scoreCounts)
+                count = int(reader.read<quint32>());
+
+        preferences.resize(qsizetype(candidateCount) * candidateCount);
+        for(int& count : preferences)
+            count = int(reader.read<quint32>());
+
+        if(reader.hasOverrun())
+            return RefBinarySummaryError(RefBinarySummaryError::Truncated);
+
+        mTargetList->append(ElectionSummary::Builder(name)
+                            .wSeatCount(seats)
+                            .wTally(candidates, ballotCount,
+                                    std::span<const Election::ScoreStatistics>(statistics.constData(), statistics.size()),
+                                    std::span<const int>(preferences.constData(), preferences.size()))
+                            .build());
+    }
+
+    return RefBinarySummaryError();
+}
+
+//Public:
+RefBinarySummaryError RefBinarySummary::Reader::readInto()
+{
+    // Clear return buffer
+    mTargetList->clear();
+
+    if(!mFile.open(QIODevice::ReadOnly))
+        return RefBinarySummaryError(RefBinarySummaryError::IoError, mFile.errorString());
+
+    if(mFile.size() < HEADER_SIZE)
+        return RefBinarySummaryError(RefBinarySummaryError::Truncated);
+
+    // Summaries are small, so they're simply read in their entirety
+    QByteArray contents = mFile.readAll();
+    if(mFile.error() != QFileDevice::NoError)
+        return RefBinarySummaryError(RefBinarySummaryError::IoError, mFile.errorString());
+
+    return parse(contents);
+}
+
+//===============================================================================================================
+// RefBinarySummary::Writer
+//===============================================================================================================
+
+//-Constructor-----------------------------------------------------------------------------------------------------
+//Public:
+RefBinarySummary::Writer::Writer(const QList<ElectionSummary>* sourceList, const QString& filePath, bool checksum) :
+    mSourceList(sourceList),
+    mFilePath(filePath),
+    mChecksum(checksum)
+{}
+
+//-Instance Functions-------------------------------------------------------------------------------------------------
+//Public:
+RefBinarySummaryError RefBinarySummary::Writer::write()
+{
+    // Without preferences a summary cannot stand in for its ballots
+    for(const ElectionSummary& summary : *mSourceList)
+        if(!summary.hasPreferences())
+            return RefBinarySummaryError(RefBinarySummaryError::MissingPreferences);
+
+    // Write to a temporary file that only replaces the target once complete
+    QSaveFile file(mFilePath);
+    if(!file.open(QIODevice::WriteOnly))
+        return RefBinarySummaryError(RefBinarySummaryError::IoError, file.errorString());
+
+    ByteWriter writer(&file, mChecksum);
+
+    // Header
+    writer.write(MAGIC);
+    writer.write(VERSION);
+    writer.write(mChecksum ? FLAG_CHECKSUM : quint16(0));
+    writer.write(quint32(mSourceList->size()));
+
+    // Categories
+    for(const ElectionSummary& summary : *mSourceList)
+    {
+        writer.writeString(summary.name());
+        writer.write(quint32(summary.seatCount()));
+        writer.write(quint64(summary.ballotCount()));
+        writer.write(quint32(summary.candidateCount()));
+        for(const QString& candidate : summary.candidates())
+            writer.writeString(candidate);
+
+        for(int id = 0; id < summary.candidateCount(); id++)
+            for(int count : summary.statistics(id).scoreCounts)
+                writer.write(quint32(count));
+
+        for(int a = 0; a < summary.candidateCount(); a++)
+            for(int b = 0; b < summary.candidateCount(); b++)
+                writer.write(quint32(summary.preferences(a, b)));
+    }
+
+    // Checksum of everything prior
+    if(mChecksum)
+        writer.write(writer.checksum());
+
+    if(writer.hasFailed() || !file.commit())
+        return RefBinarySummaryError(RefBinarySummaryError::IoError, file.errorString());
+
+    return RefBinarySummaryError();
+}
+/*! @endcond */
+}
@@ -0,0 +1,133 @@
+#ifndef BINARYSUMMARY_P_H
+#define BINARYSUMMARY_P_H
+
+// Qt Includes
+#include <QString>
+#include <QList>
+#include <QFile>
+
+// Qx Includes
+#include <qx/core/qx-abstracterror.h>
+
+// Project Includes
+#include "star/electionsummary.h"
+
+namespace Star
+{
+/*! @cond */
+
+class QX_ERROR_TYPE(RefBinarySummaryError, "Star::RefBinarySummaryError", 1154)
+{
+    friend class RefBinarySummary;
+//-Class Enums-------------------------------------------------------------
+public:
+    enum Type
+    {
+        NoError,
+        InvalidFormat,
+        UnsupportedVersion,
+        Truncated,
+        ChecksumMismatch,
+        MissingPreferences,
+        IoError
+    };
+
+//-Class Variables-------------------------------------------------------------
+private:
+    static inline const QString MAIN_ERR_MSG = u"Error processing the binary summary."_s;
+    static inline const QHash<Type, QString> ERR_STRINGS{
+        {NoError, u""_s},
+        {InvalidFormat, u"The provided file is not a valid binary summary."_s},
+        {UnsupportedVersion, u"The binary summary is of an unsupported version (%1)."_s},
+        {Truncated, u"The binary summary ended unexpectedly."_s},
+        {ChecksumMismatch, u"The binary summary checksum does not match its contents."_s},
+        {MissingPreferences, u"Only summaries that include head-to-head preferences can be saved."_s},
+        {IoError, u"IO Error: %1"_s}
+    };
+
+//-Instance Variables-------------------------------------------------------------
+private:
+    Type mType;
+    QString mString;
+
+//-Constructor-------------------------------------------------------------
+private:
+    RefBinarySummaryError(Type t = NoError);
+
+    template<typename Arg>
+        requires std::same_as<Arg, QString> || std::integral<Arg>
+    RefBinarySummaryError(Type t, Arg arg) :
+        RefBinarySummaryError(t)
+    {
+        mString = mString.arg(arg);
+    }
+
+//-Instance Functions-------------------------------------------------------------
+public:
+    bool isValid() const;
+    Type type() const;
+    QString string() const;
+
+private:
+    Qx::Severity deriveSeverity() const override;
+    quint32 deriveValue() const override;
+    QString derivePrimary() const override;
+    QString deriveSecondary() const override;
+};
+
+class RefBinarySummary
+{
+//-Inner Classes----------------------------------------------------------------------------------------------------
+public:
+    class Reader;
+    class Writer;
+
+//-Class Variables--------------------------------------------------------------------------------------------------
+private:
+    // Layout
+    static inline const QByteArray MAGIC = QByteArrayLiteral("STARSUMM");
+    static const quint16 VERSION = 1;
+    static const quint16 FLAG_CHECKSUM = 0x0001;
+    static const qsizetype HEADER_SIZE = 16;
+    static const qsizetype SCORE_COUNT = Election::ScoreStatistics::MAX_SCORE + 1;
+};
+
+class RefBinarySummary::Reader
+{
+//-Instance Variables--------------------------------------------------------------------------------------------------
+private:
+    QList<ElectionSummary>* mTargetList;
+    QFile mFile;
+
+//-Constructor--------------------------------------------------------------------------------------------------------
+public:
+    Reader(QList<ElectionSummary>* targetList, const QString& filePath);
+
+//-Instance Functions-------------------------------------------------------------------------------------------------
+private:
+    RefBinarySummaryError parse(QByteArrayView data);
+
+public:
+    RefBinarySummaryError readInto();
+};
+
+class RefBinarySummary::Writer
+{
+//-Instance Variables--------------------------------------------------------------------------------------------------
+private:
+    const QList<ElectionSummary>* mSourceList;
+    QString mFilePath;
+    bool mChecksum;
+
+//-Constructor--------------------------------------------------------------------------------------------------------
+public:
+    Writer(const QList<ElectionSummary>* sourceList, const QString& filePath, bool checksum);
+
+//-Instance Functions-------------------------------------------------------------------------------------------------
+public:
+    RefBinarySummaryError write();
+};
+/*! @endcond */
+}
+
+#endif // BINARYSUMMARY_P_H
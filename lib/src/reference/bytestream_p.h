@@ -0,0 +1,130 @@
+#ifndef BYTESTREAM_P_H
+#define BYTESTREAM_P_H
+
+// Standard Library Includes
+#include <optional>
+
+// Qt Includes
+#include <QString>
+#include <QByteArrayView>
+#include <QIODevice>
+#include <QCryptographicHash>
+#include <QtEndian>
+
+namespace Star
+{
+/*! @cond */
+
+// Used for the optional checksums of all binary reference formats
+const QCryptographicHash::Algorithm REF_CHECKSUM_ALGORITHM = QCryptographicHash::Md5;
+
+// Bounds checked sequential reading of little-endian values from a block of memory
+class ByteReader
+{
+private:
+    QByteArrayView mData;
+    qsizetype mPos;
+    bool mOverrun;
+
+public:
+    ByteReader(QByteArrayView data) :
+        mData(data),
+        mPos(0),
+        mOverrun(false)
+    {}
+
+    bool hasOverrun() const { return mOverrun; }
+    qsizetype pos() const { return mPos; }
+
+    QByteArrayView take(qsizetype size)
+    {
+        if(mOverrun || size < 0 || size > mData.size() - mPos)
+        {
+            mOverrun = true;
+            return QByteArrayView();
+        }
+
+        QByteArrayView bytes = mData.sliced(mPos, size);
+        mPos += size;
+        return bytes;
+    }
+
+    template<typename T>
+        requires std::integral<T>
+    T read()
+    {
+        QByteArrayView bytes = take(sizeof(T));
+        return mOverrun ? T(0) : qFromLittleEndian<T>(bytes.data());
+    }
+
+    QString readString()
+    {
+        quint32 size = read<quint32>();
+        return QString::fromUtf8(take(size));
+    }
+
+    void align(qsizetype alignment) { take((alignment - mPos % alignment) % alignment); }
+};
+
+// Sequential writing of little-endian values to a device, while optionally hashing everything written
+class ByteWriter
+{
+private:
+    QIODevice* mDevice;
+    std::optional<QCryptographicHash> mHash;
+    qint64 mPos;
+    bool mFailed;
+
+public:
+    ByteWriter(QIODevice* device, bool hash) :
+        mDevice(device),
+        mPos(0),
+        mFailed(false)
+    {
+        if(hash)
+            mHash.emplace(REF_CHECKSUM_ALGORITHM);
+    }
+
+    bool hasFailed() const { return mFailed; }
+
+    void write(QByteArrayView bytes)
+    {
+        if(mFailed)
+            return;
+
+        if(mDevice->write(bytes.data(), bytes.size()) != bytes.size())
+            mFailed = true;
+        else if(mHash)
+            mHash->addData(bytes);
+
+        mPos += bytes.size();
+    }
+
+    template<typename T>
+        requires std::integral<T>
+    void write(T value)
+    {
+        char bytes[sizeof(T)];
+        qToLittleEndian(value, bytes);
+        write(QByteArrayView(bytes, sizeof(T)));
+    }
+
+    void writeString(const QString& str)
+    {
+        QByteArray utf8 = str.toUtf8();
+        write(quint32(utf8.size()));
+        write(utf8);
+    }
+
+    void align(qsizetype alignment)
+    {
+        static const char padding[16] = {};
+        write(QByteArrayView(padding, (alignment - mPos % alignment) % alignment));
+    }
+
+    QByteArray checksum() const { return mHash ? mHash->result() : QByteArray(); }
+};
+/*! @endcond */
+}
+
+#endif // BYTESTREAM_P_H
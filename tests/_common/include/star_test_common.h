@@ -1,4 +1,5 @@
 #include <star/election.h>
+#include <star/electionsummary.h>
 #include <star/electionresult.h>
 #include <star/expectedelectionresult.h>
 
@@ -60,3 +61,54 @@ char* toString(const ElectionResult& er)
 }
 
 }
+
+// Shared checks
+namespace Star
+{
+
+QList<quint8> ballotScores(const Election& election, qsizetype ballot)
+{
+    QList<quint8> scores;
+    for(int id = 0; id < election.candidateCount(); id++)
+        scores.append(election.score(id, ballot));
+
+    return scores;
+}
+
+void compareTallies(const Election& actual, const Election& expected)
+{
+    // Weighted ballots count for as many of the expected election's ballots as their weight
+    QCOMPARE(actual.totalWeight(), expected.ballotCount());
+
+    for(int id = 0; id < expected.candidateCount(); id++)
+        QVERIFY(actual.statistics(id).scoreCounts == expected.statistics(id).scoreCounts);
+
+    const QList<Rank>& actualRanks = actual.scoreRankings();
+    const QList<Rank>& expectedRanks = expected.scoreRankings();
+    QCOMPARE(actualRanks.size(), expectedRanks.size());
+    for(qsizetype r = 0; r < expectedRanks.size(); r++)
+    {
+        QCOMPARE(actualRanks.at(r).value, expectedRanks.at(r).value);
+        QCOMPARE(actualRanks.at(r).candidates, expectedRanks.at(r).candidates);
+    }
+
+    // Preferences tallied from the actual election must match those determined directly from every expected ballot
+    Election tallied = actual;
+    tallied.enableLiveTally();
+    ElectionSummary summary = tallied.summary();
+    for(int a = 0; a < expected.candidateCount(); a++)
+    {
+        for(int b = 0; b < expected.candidateCount(); b++)
+        {
+            std::span<const quint8> scoresA = expected.scores(a);
+            std::span<const quint8> scoresB = expected.scores(b);
+            int preferred = 0;
+            for(qsizetype i = 0; i < expected.ballotCount(); i++)
+                preferred += scoresA[i] > scoresB[i];
+
+            QCOMPARE(summary.preferences(a, b), preferred);
+        }
+    }
+}
+
+}
@@ -0,0 +1,107 @@
+// Qt Includes
+#include <QtTest>
+
+// Base Includes
+#include "candidateset.h"
+
+// Test
+class tst_candidate_set : public QObject
+{
+    Q_OBJECT
+
+public:
+    tst_candidate_set();
+
+private slots:
+    // Init
+//    void initTestCase();
+//    void cleanupTestCase();
+
+    // Test cases
+    void equality_data();
+    void equality();
+    void capacity();
+
+};
+
+tst_candidate_set::tst_candidate_set() {}
+//void tst_candidate_set::initTestCase() {}
+//void tst_candidate_set::cleanupTestCase() {}
+
+void tst_candidate_set::equality_data()
+{
+    // Setup test table
+    QTest::addColumn<QList<int>>("ids_a");
+    QTest::addColumn<int>("capacity_a");
+    QTest::addColumn<QList<int>>("ids_b");
+    QTest::addColumn<int>("capacity_b");
+    QTest::addColumn<bool>("equal");
+
+    //-Populate test table rows with each case-----------------------------
+
+    QTest::newRow("Empty, no capacity") << QList<int>{} << 0 << QList<int>{} << 0 << true;
+    QTest::newRow("Empty, different capacity") << QList<int>{} << 0 << QList<int>{} << 200 << true;
+    QTest::newRow("Same members, same capacity") << QList<int>{1, 5} << 10 << QList<int>{5, 1} << 10 << true;
+    QTest::newRow("Same members, shorter first") << QList<int>{3} << 0 << QList<int>{3} << 200 << true;
+    QTest::newRow("Same members, longer first") << QList<int>{3, 70} << 300 << QList<int>{3, 70} << 0 << true;
+    QTest::newRow("Different members, same word") << QList<int>{3} << 64 << QList<int>{4} << 64 << false;
+    QTest::newRow("Extra member beyond shorter side") << QList<int>{3} << 0 << QList<int>{3, 130} << 200 << false;
+    QTest::newRow("Removed member beyond shorter side") << QList<int>{3, 130} << 0 << QList<int>{3} << 0 << false;
+}
+
+void tst_candidate_set::equality()
+{
+    // Fetch data from test table
+    QFETCH(QList<int>, ids_a);
+    QFETCH(int, capacity_a);
+    QFETCH(QList<int>, ids_b);
+    QFETCH(int, capacity_b);
+    QFETCH(bool, equal);
+
+    // Build sets
+    Star::CandidateSet a(capacity_a);
+    for(int id : ids_a)
+        a.insert(id);
+
+    Star::CandidateSet b(capacity_b);
+    for(int id : ids_b)
+        b.insert(id);
+
+    // Test
+    QCOMPARE(a == b, equal);
+    QCOMPARE(b == a, equal);
+}
+
+void tst_candidate_set::capacity()
+{
+    // Capacity given up front
+    Star::CandidateSet sized(200);
+    QCOMPARE(sized.capacity(), 200);
+    QVERIFY(sized.isEmpty());
+
+    // Filled sets only contain candidates within their capacity
+    Star::CandidateSet filled(70, true);
+    QCOMPARE(filled.capacity(), 70);
+    QCOMPARE(filled.count(), 70);
+    QVERIFY(!filled.contains(70));
+
+    // Inserting beyond the capacity grows it
+    Star::CandidateSet grown;
+    QCOMPARE(grown.capacity(), 0);
+    grown.insert(3);
+    QCOMPARE(grown.capacity(), 4);
+    grown.insert(129);
+    QCOMPARE(grown.capacity(), 130);
+
+    // Uniting takes the larger capacity
+    Star::CandidateSet united(10);
+    united.unite(sized);
+    QCOMPARE(united.capacity(), 200);
+
+    // Removing members doesn't shrink it
+    grown.remove(129);
+    QCOMPARE(grown.capacity(), 130);
+}
+
+QTEST_APPLESS_MAIN(tst_candidate_set)
+#include "tst_candidate_set.moc"
@@ -0,0 +1,240 @@
+// Qt Includes
+#include <QtTest>
+
+// Base Includes
+#include <star/reference.h>
+#include <star/calculator.h>
+#include <star/electionsummary.h>
+
+// Test Includes
+#include <star_test_common.h>
+
+class tst_election_summary : public QObject
+{
+    Q_OBJECT
+
+public:
+    tst_election_summary();
+
+private:
+    // Helpers
+    static void compareSummary(const Star::ElectionSummary& summary, const Star::Election& full);
+    static Star::ElectionSummary summarizeRange(const Star::Election& full, qsizetype start, qsizetype end);
+
+private slots:
+    // Init
+//    void initTestCase();
+//    void cleanupTestCase();
+
+    // Test cases
+    void summary_only_results_data();
+    void summary_only_results();
+    void merged_partials_data();
+    void merged_partials();
+
+};
+
+tst_election_summary::tst_election_summary() {}
+//void tst_election_summary::initTestCase() {}
+//void tst_election_summary::cleanupTestCase() {}
+
+void tst_election_summary::compareSummary(const Star::ElectionSummary& summary, const Star::Election& full)
+{
+    QCOMPARE(summary.name(), full.name());
+    QCOMPARE(summary.candidates(), full.candidates());
+    QCOMPARE(summary.ballotCount(), full.ballotCount());
+    QCOMPARE(summary.seatCount(), full.seatCount());
+
+    for(int id = 0; id < full.candidateCount(); id++)
+        QVERIFY(summary.statistics(id).scoreCounts == full.statistics(id).scoreCounts);
+
+    const QList<Star::Rank>& summaryRanks = summary.scoreRankings();
+    const QList<Star::Rank>& fullRanks = full.scoreRankings();
+    QCOMPARE(summaryRanks.size(), fullRanks.size());
+    for(qsizetype r = 0; r < fullRanks.size(); r++)
+    {
+        QCOMPARE(summaryRanks.at(r).value, fullRanks.at(r).value);
+        QCOMPARE(summaryRanks.at(r).candidates, fullRanks.at(r).candidates);
+    }
+
+    // Every preference must match one determined directly from the ballots
+    QVERIFY(summary.hasPreferences());
+    for(int a = 0; a < full.candidateCount(); a++)
+    {
+        for(int b = 0; b < full.candidateCount(); b++)
+        {
+            std::span<const quint8> scoresA = full.scores(a);
+            std::span<const quint8> scoresB = full.scores(b);
+            int preferred = 0;
+            for(qsizetype i = 0; i < full.ballotCount(); i++)
+                preferred += scoresA[i] > scoresB[i];
+
+            QCOMPARE(summary.preferences(a, b), preferred);
+        }
+    }
+}
+
+Star::ElectionSummary tst_election_summary::summarizeRange(const Star::Election& full, qsizetype start, qsizetype end)
+{
+    Star::ElectionSummary::Builder sb(full.name());
+    sb.wCandidates(full.candidates()).wSeatCount(full.seatCount());
+
+    QList<quint8> scores(full.candidateCount());
+    for(qsizetype b = start; b < end; b++)
+    {
+        for(int id = 0; id < full.candidateCount(); id++)
+            scores[id] = full.scores(id)[b];
+
+        sb.wBallot(scores);
+    }
+
+    return sb.build();
+}
+
+void tst_election_summary::summary_only_results_data()
+{
+    // Setup test table
+    QTest::addColumn<QString>("bb_path");
+    QTest::addColumn<QString>("cc_path");
+    QTest::addColumn<QString>("er_path");
+    QTest::addColumn<QString>("op_path");
+
+    // Populate test table rows from file
+    QDir data(":/data");
+    QFileInfoList dataFiles = data.entryInfoList(QDir::NoFilter, QDir::Name);
+    QVERIFY(dataFiles.size() % 4 == 0);
+
+    qsizetype testSets = dataFiles.size()/4;
+    for(qsizetype i = 0; i < testSets; i++)
+    {
+        qsizetype fileStart = i * 4;
+        const QFileInfo& bbFile = dataFiles[fileStart];
+        const QFileInfo& ccFile = dataFiles[fileStart + 1];
+        const QFileInfo& erFile = dataFiles[fileStart + 2];
+        const QFileInfo& opFile = dataFiles[fileStart + 3];
+
+        QVERIFY(bbFile.baseName() == ccFile.baseName() && bbFile.baseName() == erFile.baseName() && bbFile.baseName() == opFile.baseName());
+
+        QTest::newRow(C_STR(bbFile.baseName())) << bbFile.filePath() << ccFile.filePath() << erFile.filePath() << opFile.filePath();
+    }
+}
+
+void tst_election_summary::summary_only_results()
+{
+    // Fetch data from test table
+    QFETCH(QString, bb_path);
+    QFETCH(QString, cc_path);
+    QFETCH(QString, er_path);
+    QFETCH(QString, op_path);
+
+    // Load expected results
+    QList<Star::ExpectedElectionResult> expectedResults;
+    Star::ReferenceError expectedResultsLoadError = Star::expectedResultsFromReferenceInput(expectedResults, er_path);
+    QVERIFY2(!expectedResultsLoadError.isValid(), expectedResultsLoadError.errorDetails.toStdString().c_str());
+
+    // Load summaries, along with the full elections to check them against
+    QList<Star::ElectionSummary> summaries;
+    Star::ReferenceError summaryLoadError = Star::summariesFromReferenceInput(summaries, cc_path, bb_path);
+    QVERIFY2(!summaryLoadError.isValid(), summaryLoadError.errorDetails.toStdString().c_str());
+
+    QList<Star::Election> elections;
+    Star::ReferenceError electionLoadError = Star::electionsFromReferenceInput(elections, cc_path, bb_path);
+    QVERIFY2(!electionLoadError.isValid(), electionLoadError.errorDetails.toStdString().c_str());
+    QCOMPARE(summaries.size(), elections.size());
+
+    // Load options
+    Star::Calculator::Options cOptions;
+    Star::ReferenceError calcOptionsLoadError = Star::calculatorOptionsFromReferenceInput(cOptions, op_path);
+    QVERIFY2(!calcOptionsLoadError.isValid(), calcOptionsLoadError.errorDetails.toStdString().c_str());
+
+    // Create calculator
+    Star::Calculator calculator;
+    calculator.setOptions(cOptions);
+
+    for(qsizetype i = 0; i < summaries.size(); i++)
+    {
+        const Star::ElectionSummary& summary = summaries.at(i);
+        compareSummary(summary, elections.at(i));
+
+        // Results must be identical to those determined from the ballots
+        Star::ElectionResult result = calculator.calculateResult(summary);
+        QVERIFY(!result.election());
+        QCOMPARE(result.summary().name(), summary.name());
+        QCOMPARE(result, expectedResults.at(i));
+    }
+}
+
+void tst_election_summary::merged_partials_data() { summary_only_results_data(); }
+
+void tst_election_summary::merged_partials()
+{
+    // Fetch data from test table
+    QFETCH(QString, bb_path);
+    QFETCH(QString, cc_path);
+    QFETCH(QString, er_path);
+    QFETCH(QString, op_path);
+
+    // Load expected results
+    QList<Star::ExpectedElectionResult> expectedResults;
+    Star::ReferenceError expectedResultsLoadError = Star::expectedResultsFromReferenceInput(expectedResults, er_path);
+    QVERIFY2(!expectedResultsLoadError.isValid(), expectedResultsLoadError.errorDetails.toStdString().c_str());
+
+    // Load reference elections, which are split into precincts
+    QList<Star::Election> elections;
+    Star::ReferenceError electionLoadError = Star::electionsFromReferenceInput(elections, cc_path, bb_path);
+    QVERIFY2(!electionLoadError.isValid(), electionLoadError.errorDetails.toStdString().c_str());
+
+    // Load options
+    Star::Calculator::Options cOptions;
+    Star::ReferenceError calcOptionsLoadError = Star::calculatorOptionsFromReferenceInput(cOptions, op_path);
+    QVERIFY2(!calcOptionsLoadError.isValid(), calcOptionsLoadError.errorDetails.toStdString().c_str());
+
+    // Summarize three uneven precincts of each election
+    QList<QList<Star::ElectionSummary>> precincts(3);
+    for(const Star::Election& full : std::as_const(elections))
+    {
+        qsizetype firstCut = full.ballotCount() / 5;
+        qsizetype secondCut = full.ballotCount() / 2;
+        precincts[0].append(summarizeRange(full, 0, firstCut));
+        precincts[1].append(summarizeRange(full, firstCut, secondCut));
+        precincts[2].append(summarizeRange(full, secondCut, full.ballotCount()));
+    }
+
+    // Precinct summaries must survive being saved
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    for(qsizetype p = 0; p < precincts.size(); p++)
+    {
+        QString path = tempDir.filePath(QStringLiteral("precinct_%1.sts").arg(p));
+        Star::ReferenceError saveError = Star::summariesToBinaryOutput(precincts.at(p), path);
+        QVERIFY2(!saveError.isValid(), saveError.errorDetails.toStdString().c_str());
+
+        Star::ReferenceError loadError = Star::summariesFromBinaryInput(precincts[p], path);
+        QVERIFY2(!loadError.isValid(), loadError.errorDetails.toStdString().c_str());
+        QCOMPARE(precincts.at(p).size(), elections.size());
+    }
+
+    // Create calculator
+    Star::Calculator calculator;
+    calculator.setOptions(cOptions);
+
+    for(qsizetype i = 0; i < elections.size(); i++)
+    {
+        // Merge in a different grouping each time to show that order doesn't matter
+        Star::ElectionSummary::Builder lateMerge(elections.at(i).name());
+        lateMerge.wSummary(precincts.at(1).at(i)).wSummary(precincts.at(2).at(i));
+        Star::ElectionSummary lateHalf = lateMerge.build();
+
+        Star::ElectionSummary::Builder fullMerge(elections.at(i).name());
+        fullMerge.wSummary(lateHalf).wSummary(precincts.at(0).at(i));
+        Star::ElectionSummary merged = fullMerge.build();
+
+        compareSummary(merged, elections.at(i));
+
+        Star::ElectionResult result = calculator.calculateResult(merged);
+        QCOMPARE(result, expectedResults.at(i));
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_election_summary)
+#include "tst_election_summary.moc"
@@ -23,6 +23,10 @@ private slots:
     // Test cases
     void various_ref_elections_data();
     void various_ref_elections();
+    void shared_calculator_data();
+    void shared_calculator();
+    void async_calculation_data();
+    void async_calculation();
 
 };
 
@@ -96,5 +100,134 @@ void tst_full_reference_election::various_ref_elections()
     }
 }
 
+void tst_full_reference_election::shared_calculator_data() { various_ref_elections_data(); }
+
+void tst_full_reference_election::shared_calculator()
+{
+    // Fetch data from test table
+    QFETCH(QString, bb_path);
+    QFETCH(QString, cc_path);
+    QFETCH(QString, er_path);
+    QFETCH(QString, op_path);
+
+    // Load expected results
+    QList<Star::ExpectedElectionResult> expectedResults;
+    Star::ReferenceError expectedResultsLoadError = Star::expectedResultsFromReferenceInput(expectedResults, er_path);
+    QVERIFY2(!expectedResultsLoadError.isValid(), expectedResultsLoadError.errorDetails.toStdString().c_str());
+
+    // Load reference elections
+    QList<Star::Election> elections;
+    Star::ReferenceError electionLoadError = Star::electionsFromReferenceInput(elections, cc_path, bb_path);
+    QVERIFY2(!electionLoadError.isValid(), electionLoadError.errorDetails.toStdString().c_str());
+
+    // Load options
+    Star::Calculator::Options cOptions;
+    Star::ReferenceError calcOptionsLoadError = Star::calculatorOptionsFromReferenceInput(cOptions, op_path);
+    QVERIFY2(!calcOptionsLoadError.isValid(), calcOptionsLoadError.errorDetails.toStdString().c_str());
+
+    // Create one calculator for every thread
+    Star::Calculator calculator;
+    calculator.setOptions(cOptions);
+    calculator.setTraceEnabled(true);
+
+    // Trace each election one at a time for comparison
+    QList<QStringList> expectedTraces;
+    for(const Star::Election& election : std::as_const(elections))
+    {
+        calculator.setElection(&election);
+        calculator.calculateResult();
+        expectedTraces.append(calculator.trace().render());
+    }
+
+    // Evaluate every election several times over at once
+    const qsizetype repeats = 4;
+    qsizetype callCount = elections.size() * repeats;
+    QList<Star::ElectionResult> results(callCount);
+    QList<Star::CalculationTrace> traces(callCount);
+    Star::ElectionResult* resultData = results.data();
+    Star::CalculationTrace* traceData = traces.data();
+    const Star::Calculator& shared = calculator;
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+    for(qsizetype c = 0; c < callCount; c++)
+    {
+        const Star::Election* election = &elections.at(c % elections.size());
+        pool.start([=, &shared]{ resultData[c] = shared.evaluate(election, &traceData[c]); });
+    }
+    pool.waitForDone();
+
+    // Each call must be unaffected by the others, and by the trace of the calculator itself
+    for(qsizetype c = 0; c < callCount; c++)
+    {
+        qsizetype i = c % elections.size();
+        QCOMPARE(results.at(c), expectedResults.at(i));
+        QCOMPARE(traces.at(c).render(), expectedTraces.at(i));
+    }
+}
+
+void tst_full_reference_election::async_calculation_data() { various_ref_elections_data(); }
+
+void tst_full_reference_election::async_calculation()
+{
+    // Fetch data from test table
+    QFETCH(QString, bb_path);
+    QFETCH(QString, cc_path);
+    QFETCH(QString, er_path);
+    QFETCH(QString, op_path);
+
+    // Load expected results
+    QList<Star::ExpectedElectionResult> expectedResults;
+    Star::ReferenceError expectedResultsLoadError = Star::expectedResultsFromReferenceInput(expectedResults, er_path);
+    QVERIFY2(!expectedResultsLoadError.isValid(), expectedResultsLoadError.errorDetails.toStdString().c_str());
+
+    // Load reference elections
+    QList<Star::Election> elections;
+    Star::ReferenceError electionLoadError = Star::electionsFromReferenceInput(elections, cc_path, bb_path);
+    QVERIFY2(!electionLoadError.isValid(), electionLoadError.errorDetails.toStdString().c_str());
+
+    // Load options
+    Star::Calculator::Options cOptions;
+    Star::ReferenceError calcOptionsLoadError = Star::calculatorOptionsFromReferenceInput(cOptions, op_path);
+    QVERIFY2(!calcOptionsLoadError.isValid(), calcOptionsLoadError.errorDetails.toStdString().c_str());
+
+    // Create calculator
+    Star::Calculator calculator;
+    calculator.setOptions(cOptions);
+
+    // Start every election at once
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+    QList<QFuture<Star::ElectionResult>> futures;
+    for(const Star::Election& election : std::as_const(elections))
+        futures.append(calculator.evaluateAsync(&election, &pool));
+
+    for(qsizetype i = 0; i < elections.size(); i++)
+    {
+        QFuture<Star::ElectionResult>& future = futures[i];
+        future.waitForFinished();
+        QVERIFY(!future.isCanceled());
+        QCOMPARE(future.result(), expectedResults.at(i));
+        QCOMPARE(future.progressValue(), future.progressMaximum());
+    }
+
+    // An election canceled before it starts must never be evaluated
+    if(!elections.isEmpty())
+    {
+        QSemaphore blocker;
+        QThreadPool busyPool;
+        busyPool.setMaxThreadCount(1);
+        busyPool.start([&blocker]{ blocker.acquire(); });
+
+        QFuture<Star::ElectionResult> canceled = calculator.evaluateAsync(&elections.first(), &busyPool);
+        canceled.cancel();
+        blocker.release();
+        busyPool.waitForDone();
+
+        QVERIFY(canceled.isCanceled());
+        QCOMPARE(canceled.resultCount(), 0);
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_full_reference_election)
 #include "tst_full_reference_election.moc"
@@ -0,0 +1,125 @@
+// Qt Includes
+#include <QtTest>
+
+// Base Includes
+#include <star/reference.h>
+#include <star/calculator.h>
+
+// Test Includes
+#include <star_test_common.h>
+
+class tst_live_tally : public QObject
+{
+    Q_OBJECT
+
+public:
+    tst_live_tally();
+
+private slots:
+    // Init
+//    void initTestCase();
+//    void cleanupTestCase();
+
+    // Test cases
+    void incremental_replay_data();
+    void incremental_replay();
+
+};
+
+tst_live_tally::tst_live_tally() {}
+//void tst_live_tally::initTestCase() {}
+//void tst_live_tally::cleanupTestCase() {}
+
+void tst_live_tally::incremental_replay_data()
+{
+    // Setup test table
+    QTest::addColumn<QString>("bb_path");
+    QTest::addColumn<QString>("cc_path");
+    QTest::addColumn<QString>("er_path");
+    QTest::addColumn<QString>("op_path");
+
+    // Populate test table rows from file
+    QDir data(":/data");
+    QFileInfoList dataFiles = data.entryInfoList(QDir::NoFilter, QDir::Name);
+    QVERIFY(dataFiles.size() % 4 == 0);
+
+    qsizetype testSets = dataFiles.size()/4;
+    for(qsizetype i = 0; i < testSets; i++)
+    {
+        qsizetype fileStart = i * 4;
+        const QFileInfo& bbFile = dataFiles[fileStart];
+        const QFileInfo& ccFile = dataFiles[fileStart + 1];
+        const QFileInfo& erFile = dataFiles[fileStart + 2];
+        const QFileInfo& opFile = dataFiles[fileStart + 3];
+
+        QVERIFY(bbFile.baseName() == ccFile.baseName() && bbFile.baseName() == erFile.baseName() && bbFile.baseName() == opFile.baseName());
+
+        QTest::newRow(C_STR(bbFile.baseName())) << bbFile.filePath() << ccFile.filePath() << erFile.filePath() << opFile.filePath();
+    }
+}
+
+void tst_live_tally::incremental_replay()
+{
+    // Fetch data from test table
+    QFETCH(QString, bb_path);
+    QFETCH(QString, cc_path);
+    QFETCH(QString, er_path);
+    QFETCH(QString, op_path);
+
+    // Load expected results
+    QList<Star::ExpectedElectionResult> expectedResults;
+    Star::ReferenceError expectedResultsLoadError = Star::expectedResultsFromReferenceInput(expectedResults, er_path);
+    QVERIFY2(!expectedResultsLoadError.isValid(), expectedResultsLoadError.errorDetails.toStdString().c_str());
+
+    // Load reference elections, which are the full rebuilds to match
+    QList<Star::Election> elections;
+    Star::ReferenceError electionLoadError = Star::electionsFromReferenceInput(elections, cc_path, bb_path);
+    QVERIFY2(!electionLoadError.isValid(), electionLoadError.errorDetails.toStdString().c_str());
+
+    // Load options
+    Star::Calculator::Options cOptions;
+    Star::ReferenceError calcOptionsLoadError = Star::calculatorOptionsFromReferenceInput(cOptions, op_path);
+    QVERIFY2(!calcOptionsLoadError.isValid(), calcOptionsLoadError.errorDetails.toStdString().c_str());
+
+    // Create calculator
+    Star::Calculator calculator;
+    calculator.setOptions(cOptions);
+
+    for(qsizetype i = 0; i < elections.size(); i++)
+    {
+        const Star::Election& full = elections.at(i);
+
+        // Start from an empty live election with the same candidates
+        Star::Election live = Star::Election::Builder(full.name())
+                              .wCandidates(full.candidates())
+                              .wSeatCount(full.seatCount())
+                              .build();
+        live.enableLiveTally();
+
+        // Replay every ballot, along with some that are later retracted
+        qsizetype spurious = std::min(full.ballotCount(), qsizetype(10));
+        for(qsizetype b = 0; b < full.ballotCount(); b++)
+        {
+            live.appendBallot(full.ballotAt(b).voter(), Star::ballotScores(full, b));
+            if(b < spurious)
+                live.appendBallot(full.ballotAt(b).voter(), QList<quint8>(full.candidateCount(), Star::Election::ScoreStatistics::MAX_SCORE));
+        }
+
+        for(qsizetype s = 0; s < spurious; s++)
+        {
+            // The spurious ballots are at every odd index below 2 * spurious, and retracting one moves the last ballot into its place
+            qsizetype spuriousIdx = 2 * (spurious - 1 - s) + 1;
+            live.retractBallot(spuriousIdx);
+        }
+
+        Star::compareTallies(live, full);
+
+        // Results must be identical to those of the full rebuild
+        calculator.setElection(&live);
+        Star::ElectionResult result = calculator.calculateResult();
+        QCOMPARE(result, expectedResults.at(i));
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_live_tally)
+#include "tst_live_tally.moc"
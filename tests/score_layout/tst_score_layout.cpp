@@ -0,0 +1,239 @@
+// Qt Includes
+#include <QtTest>
+
+// Base Includes
+#include <star/reference.h>
+#include <star/calculator.h>
+#include <star/electionsummary.h>
+
+// Test Includes
+#include <star_test_common.h>
+
+class tst_score_layout : public QObject
+{
+    Q_OBJECT
+
+public:
+    tst_score_layout();
+
+private:
+    // Helpers
+    static Star::Election rebuild(const Star::Election& full, Star::Election::ScoreLayout layout, bool collapse);
+    static void verifyLayout(Star::Election::ScoreLayout layout);
+
+private slots:
+    // Init
+//    void initTestCase();
+//    void cleanupTestCase();
+
+    // Test cases
+    void bit_planes_data();
+    void bit_planes();
+    void sparse_data();
+    void sparse();
+    void sparse_write_ins();
+
+};
+
+tst_score_layout::tst_score_layout() {}
+//void tst_score_layout::initTestCase() {}
+//void tst_score_layout::cleanupTestCase() {}
+
+Star::Election tst_score_layout::rebuild(const Star::Election& full, Star::Election::ScoreLayout layout, bool collapse)
+{
+    Star::Election::Builder eb(full.name());
+    eb.wCandidates(full.candidates()).wSeatCount(full.seatCount()).wScoreLayout(layout).wCollapseDuplicates(collapse);
+    for(qsizetype b = 0; b < full.ballotCount(); b++)
+        eb.wBallot(full.ballotAt(b).voter(), Star::ballotScores(full, b));
+
+    return eb.build();
+}
+
+void tst_score_layout::bit_planes_data()
+{
+    // Setup test table
+    QTest::addColumn<QString>("bb_path");
+    QTest::addColumn<QString>("cc_path");
+    QTest::addColumn<QString>("er_path");
+    QTest::addColumn<QString>("op_path");
+
+    // Populate test table rows from file
+    QDir data(":/data");
+    QFileInfoList dataFiles = data.entryInfoList(QDir::NoFilter, QDir::Name);
+    QVERIFY(dataFiles.size() % 4 == 0);
+
+    qsizetype testSets = dataFiles.size()/4;
+    for(qsizetype i = 0; i < testSets; i++)
+    {
+        qsizetype fileStart = i * 4;
+        const QFileInfo& bbFile = dataFiles[fileStart];
+        const QFileInfo& ccFile = dataFiles[fileStart + 1];
+        const QFileInfo& erFile = dataFiles[fileStart + 2];
+        const QFileInfo& opFile = dataFiles[fileStart + 3];
+
+        QVERIFY(bbFile.baseName() == ccFile.baseName() && bbFile.baseName() == erFile.baseName() && bbFile.baseName() == opFile.baseName());
+
+        QTest::newRow(C_STR(bbFile.baseName())) << bbFile.filePath() << ccFile.filePath() << erFile.filePath() << opFile.filePath();
+    }
+}
+
+void tst_score_layout::verifyLayout(Star::Election::ScoreLayout layout)
+{
+    // Fetch data from test table
+    QFETCH(QString, bb_path);
+    QFETCH(QString, cc_path);
+    QFETCH(QString, er_path);
+    QFETCH(QString, op_path);
+
+    // Load expected results
+    QList<Star::ExpectedElectionResult> expectedResults;
+    Star::ReferenceError expectedResultsLoadError = Star::expectedResultsFromReferenceInput(expectedResults, er_path);
+    QVERIFY2(!expectedResultsLoadError.isValid(), expectedResultsLoadError.errorDetails.toStdString().c_str());
+
+    // Load reference elections, which store their scores as bytes
+    QList<Star::Election> elections;
+    Star::ReferenceError electionLoadError = Star::electionsFromReferenceInput(elections, cc_path, bb_path);
+    QVERIFY2(!electionLoadError.isValid(), electionLoadError.errorDetails.toStdString().c_str());
+
+    // Load options
+    Star::Calculator::Options cOptions;
+    Star::ReferenceError calcOptionsLoadError = Star::calculatorOptionsFromReferenceInput(cOptions, op_path);
+    QVERIFY2(!calcOptionsLoadError.isValid(), calcOptionsLoadError.errorDetails.toStdString().c_str());
+
+    // Create calculator
+    Star::Calculator calculator;
+    calculator.setOptions(cOptions);
+
+    for(qsizetype i = 0; i < elections.size(); i++)
+    {
+        const Star::Election& full = elections.at(i);
+
+        // Every ballot must read back exactly as it was given
+        Star::Election rebuilt = rebuild(full, layout, false);
+        QCOMPARE(rebuilt.ballotCount(), full.ballotCount());
+        for(qsizetype b = 0; b < full.ballotCount(); b++)
+            QCOMPARE(Star::ballotScores(rebuilt, b), Star::ballotScores(full, b));
+
+        QCOMPARE(rebuilt.scoreLayout(), layout);
+        Star::compareTallies(rebuilt, full);
+
+        // Results must be identical to those of the byte layout, with and without weights
+        calculator.setElection(&rebuilt);
+        QCOMPARE(calculator.calculateResult(), expectedResults.at(i));
+
+        Star::Election collapsed = rebuild(full, layout, true);
+        QCOMPARE(collapsed.scoreLayout(), layout);
+        Star::compareTallies(collapsed, full);
+        calculator.setElection(&collapsed);
+        QCOMPARE(calculator.calculateResult(), expectedResults.at(i));
+
+        // Replacing a ballot in place must leave no trace of the one that was removed
+        if(rebuilt.ballotCount() > 1)
+        {
+            Star::Election::Voter voter = rebuilt.ballotAt(0).voter();
+            QList<quint8> scores = Star::ballotScores(rebuilt, 0);
+
+            rebuilt.appendBallot(voter, QList<quint8>(rebuilt.candidateCount(), Star::Election::ScoreStatistics::MAX_SCORE));
+            rebuilt.retractBallot(rebuilt.ballotCount() - 1);
+            rebuilt.retractBallot(0);
+            rebuilt.appendBallot(voter, scores);
+            QCOMPARE(rebuilt.scoreLayout(), layout);
+            Star::compareTallies(rebuilt, full);
+        }
+    }
+}
+
+void tst_score_layout::bit_planes() { verifyLayout(Star::Election::BitPlanes); }
+
+void tst_score_layout::sparse_data() { bit_planes_data(); }
+void tst_score_layout::sparse() { verifyLayout(Star::Election::Sparse); }
+
+void tst_score_layout::sparse_write_ins()
+{
+    // A large field of write-ins, of which each voter only scores a few
+    const int candidateCount = 150;
+    const int ballotCount = 9000;
+    QRandomGenerator rng(2023);
+
+    QStringList candidates;
+    for(int c = 0; c < candidateCount; c++)
+        candidates.append(QStringLiteral("Write-in %1").arg(c, 3, 10, QChar('0')));
+
+    Star::Election::Builder denseBuilder(QStringLiteral("Write-ins"));
+    Star::Election::Builder sparseBuilder(QStringLiteral("Write-ins"));
+    sparseBuilder.wScoreLayout(Star::Election::Sparse);
+    for(Star::Election::Builder* eb : {&denseBuilder, &sparseBuilder})
+        eb->wCandidates(candidates).wSeatCount(1);
+
+    for(int b = 0; b < ballotCount; b++)
+    {
+        QList<Star::Election::Vote> votes;
+        int scored = rng.bounded(5);
+        for(int v = 0; v < scored; v++)
+            votes.append({.candidate = candidates.at(rng.bounded(candidateCount)), .score = rng.bounded(6)});
+
+        Star::Election::Voter voter{.name = QString(), .anonymousName = QStringLiteral("Voter %1").arg(b)};
+        denseBuilder.wBallot(voter, votes);
+        sparseBuilder.wBallot(voter, votes);
+    }
+
+    Star::Election dense = denseBuilder.build();
+    Star::Election sparse = sparseBuilder.build();
+    QCOMPARE(sparse.scoreLayout(), Star::Election::Sparse);
+    QCOMPARE(sparse.ballotCount(), dense.ballotCount());
+
+    // Only the nonzero scores may be stored, and they must read back exactly
+    for(qsizetype b = 0; b < dense.ballotCount(); b++)
+    {
+        QCOMPARE(Star::ballotScores(sparse, b), Star::ballotScores(dense, b));
+        for(const Star::Election::SparseScore& entry : sparse.sparseScores(b))
+            QVERIFY(entry.score != 0);
+    }
+
+    // Preferences tallied across several shards must match those of the dense layout
+    Star::Election denseTallied = dense;
+    denseTallied.enableLiveTally();
+    Star::Election sparseTallied = sparse;
+    sparseTallied.enableLiveTally(3);
+
+    Star::ElectionSummary denseSummary = denseTallied.summary();
+    Star::ElectionSummary sparseSummary = sparseTallied.summary();
+    for(int a = 0; a < candidateCount; a++)
+    {
+        QVERIFY(sparseSummary.statistics(a).scoreCounts == denseSummary.statistics(a).scoreCounts);
+        for(int b = 0; b < candidateCount; b++)
+            QCOMPARE(sparseSummary.preferences(a, b), denseSummary.preferences(a, b));
+    }
+
+    // The live tally must follow ballots being added and removed
+    QList<quint8> scores(candidateCount, 0);
+    scores[7] = 5;
+    scores[42] = 3;
+    for(Star::Election* election : {&denseTallied, &sparseTallied})
+    {
+        election->appendBallot(Star::Election::Voter(), scores, 4);
+        for(qsizetype b = 0; b < ballotCount * 2 / 3; b++)
+            election->retractBallot(0);
+    }
+
+    denseSummary = denseTallied.summary();
+    sparseSummary = sparseTallied.summary();
+    for(int a = 0; a < candidateCount; a++)
+        for(int b = 0; b < candidateCount; b++)
+            QCOMPARE(sparseSummary.preferences(a, b), denseSummary.preferences(a, b));
+
+    // Results must be identical to those of the dense layout, both with and without the live tally
+    Star::Calculator calculator;
+    calculator.setElection(&dense);
+    QList<Star::Seat> denseSeats = calculator.calculateResult().seats();
+    calculator.setElection(&sparse);
+    QCOMPARE(calculator.calculateResult().seats(), denseSeats);
+
+    calculator.setElection(&denseTallied);
+    denseSeats = calculator.calculateResult().seats();
+    calculator.setElection(&sparseTallied);
+    QCOMPARE(calculator.calculateResult().seats(), denseSeats);
+}
+
+QTEST_APPLESS_MAIN(tst_score_layout)
+#include "tst_score_layout.moc"
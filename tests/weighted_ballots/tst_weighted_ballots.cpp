@@ -0,0 +1,231 @@
+// Qt Includes
+#include <QtTest>
+
+// Base Includes
+#include <star/reference.h>
+#include <star/calculator.h>
+#include <star/electionsummary.h>
+
+// Test Includes
+#include <star_test_common.h>
+
+class tst_weighted_ballots : public QObject
+{
+    Q_OBJECT
+
+public:
+    tst_weighted_ballots();
+
+private:
+    // Helpers
+    static QByteArray csvField(const QString& value);
+    static bool writePatternTally(const QString& path, const QList<Star::Election>& elections);
+
+private slots:
+    // Init
+//    void initTestCase();
+//    void cleanupTestCase();
+
+    // Test cases
+    void collapsed_duplicates_data();
+    void collapsed_duplicates();
+    void pattern_tally_data();
+    void pattern_tally();
+
+};
+
+tst_weighted_ballots::tst_weighted_ballots() {}
+//void tst_weighted_ballots::initTestCase() {}
+//void tst_weighted_ballots::cleanupTestCase() {}
+
+QByteArray tst_weighted_ballots::csvField(const QString& value)
+{
+    QByteArray field = value.toUtf8();
+    field.replace('"', "\"\"");
+    return '"' + field + '"';
+}
+
+bool tst_weighted_ballots::writePatternTally(const QString& path, const QList<Star::Election>& elections)
+{
+    QFile file(path);
+    if(!file.open(QIODevice::WriteOnly))
+        return false;
+
+    // Headings, which list every category's candidates in the same order as their scores below
+    QByteArray headings = "N/A,Count";
+    for(const Star::Election& election : elections)
+        for(const QString& candidate : election.candidates())
+            headings += ',' + csvField(candidate);
+    file.write(headings + '\n');
+
+    // Count each category's patterns, interleaving the categories by writing them in reverse
+    for(qsizetype i = elections.size() - 1; i >= 0; i--)
+    {
+        const Star::Election& election = elections.at(i);
+        QMap<QList<quint8>, int> patternCounts;
+        for(qsizetype b = 0; b < election.ballotCount(); b++)
+            patternCounts[Star::ballotScores(election, b)]++;
+
+        for(auto itr = patternCounts.cbegin(); itr != patternCounts.cend(); itr++)
+        {
+            QByteArray row = csvField(election.name()) + ',' + QByteArray::number(itr.value());
+            for(quint8 score : itr.key())
+                row += ',' + QByteArray::number(score);
+            file.write(row + '\n');
+        }
+    }
+
+    return file.error() == QFileDevice::NoError;
+}
+
+void tst_weighted_ballots::collapsed_duplicates_data()
+{
+    // Setup test table
+    QTest::addColumn<QString>("bb_path");
+    QTest::addColumn<QString>("cc_path");
+    QTest::addColumn<QString>("er_path");
+    QTest::addColumn<QString>("op_path");
+
+    // Populate test table rows from file
+    QDir data(":/data");
+    QFileInfoList dataFiles = data.entryInfoList(QDir::NoFilter, QDir::Name);
+    QVERIFY(dataFiles.size() % 4 == 0);
+
+    qsizetype testSets = dataFiles.size()/4;
+    for(qsizetype i = 0; i < testSets; i++)
+    {
+        qsizetype fileStart = i * 4;
+        const QFileInfo& bbFile = dataFiles[fileStart];
+        const QFileInfo& ccFile = dataFiles[fileStart + 1];
+        const QFileInfo& erFile = dataFiles[fileStart + 2];
+        const QFileInfo& opFile = dataFiles[fileStart + 3];
+
+        QVERIFY(bbFile.baseName() == ccFile.baseName() && bbFile.baseName() == erFile.baseName() && bbFile.baseName() == opFile.baseName());
+
+        QTest::newRow(C_STR(bbFile.baseName())) << bbFile.filePath() << ccFile.filePath() << erFile.filePath() << opFile.filePath();
+    }
+}
+
+void tst_weighted_ballots::collapsed_duplicates()
+{
+    // Fetch data from test table
+    QFETCH(QString, bb_path);
+    QFETCH(QString, cc_path);
+    QFETCH(QString, er_path);
+    QFETCH(QString, op_path);
+
+    // Load expected results
+    QList<Star::ExpectedElectionResult> expectedResults;
+    Star::ReferenceError expectedResultsLoadError = Star::expectedResultsFromReferenceInput(expectedResults, er_path);
+    QVERIFY2(!expectedResultsLoadError.isValid(), expectedResultsLoadError.errorDetails.toStdString().c_str());
+
+    // Load reference elections, which hold every ballot individually
+    QList<Star::Election> elections;
+    Star::ReferenceError electionLoadError = Star::electionsFromReferenceInput(elections, cc_path, bb_path);
+    QVERIFY2(!electionLoadError.isValid(), electionLoadError.errorDetails.toStdString().c_str());
+
+    // Load options
+    Star::Calculator::Options cOptions;
+    Star::ReferenceError calcOptionsLoadError = Star::calculatorOptionsFromReferenceInput(cOptions, op_path);
+    QVERIFY2(!calcOptionsLoadError.isValid(), calcOptionsLoadError.errorDetails.toStdString().c_str());
+
+    // Create calculator
+    Star::Calculator calculator;
+    calculator.setOptions(cOptions);
+
+    for(qsizetype i = 0; i < elections.size(); i++)
+    {
+        const Star::Election& full = elections.at(i);
+
+        // Rebuild the election, letting the builder combine identical ballots
+        Star::Election::Builder eb(full.name());
+        eb.wCandidates(full.candidates()).wSeatCount(full.seatCount()).wCollapseDuplicates(true);
+        for(qsizetype b = 0; b < full.ballotCount(); b++)
+            eb.wBallot(full.ballotAt(b).voter(), Star::ballotScores(full, b));
+
+        Star::Election collapsed = eb.build();
+        QVERIFY(collapsed.ballotCount() <= full.ballotCount());
+        Star::compareTallies(collapsed, full);
+
+        // Results must be identical to those of the individual ballots
+        calculator.setElection(&collapsed);
+        Star::ElectionResult result = calculator.calculateResult();
+        QCOMPARE(result, expectedResults.at(i));
+
+        // Retracting a weighted ballot must remove all of its voters, and adding it back must restore them
+        if(collapsed.ballotCount() > 0)
+        {
+            Star::Election::Voter voter = collapsed.ballotAt(0).voter();
+            QList<quint8> scores = Star::ballotScores(collapsed, 0);
+            int weight = collapsed.ballotWeight(0);
+
+            collapsed.retractBallot(0);
+            QCOMPARE(collapsed.totalWeight(), full.ballotCount() - weight);
+            collapsed.appendBallot(voter, scores, weight);
+            Star::compareTallies(collapsed, full);
+        }
+    }
+}
+
+void tst_weighted_ballots::pattern_tally_data() { collapsed_duplicates_data(); }
+
+void tst_weighted_ballots::pattern_tally()
+{
+    // Fetch data from test table
+    QFETCH(QString, bb_path);
+    QFETCH(QString, cc_path);
+    QFETCH(QString, er_path);
+    QFETCH(QString, op_path);
+
+    // Load expected results
+    QList<Star::ExpectedElectionResult> expectedResults;
+    Star::ReferenceError expectedResultsLoadError = Star::expectedResultsFromReferenceInput(expectedResults, er_path);
+    QVERIFY2(!expectedResultsLoadError.isValid(), expectedResultsLoadError.errorDetails.toStdString().c_str());
+
+    // Load reference elections, which are aggregated into a pattern tally
+    QList<Star::Election> elections;
+    Star::ReferenceError electionLoadError = Star::electionsFromReferenceInput(elections, cc_path, bb_path);
+    QVERIFY2(!electionLoadError.isValid(), electionLoadError.errorDetails.toStdString().c_str());
+
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    QString tallyPath = tempDir.filePath(QStringLiteral("patterns.csv"));
+    QVERIFY(writePatternTally(tallyPath, elections));
+
+    // Load the tally both ways
+    QList<Star::Election> patternElections;
+    Star::ReferenceError patternLoadError = Star::electionsFromPatternInput(patternElections, cc_path, tallyPath);
+    QVERIFY2(!patternLoadError.isValid(), patternLoadError.errorDetails.toStdString().c_str());
+    QCOMPARE(patternElections.size(), elections.size());
+
+    QList<Star::ElectionSummary> patternSummaries;
+    Star::ReferenceError summaryLoadError = Star::summariesFromPatternInput(patternSummaries, cc_path, tallyPath);
+    QVERIFY2(!summaryLoadError.isValid(), summaryLoadError.errorDetails.toStdString().c_str());
+    QCOMPARE(patternSummaries.size(), elections.size());
+
+    // Load options
+    Star::Calculator::Options cOptions;
+    Star::ReferenceError calcOptionsLoadError = Star::calculatorOptionsFromReferenceInput(cOptions, op_path);
+    QVERIFY2(!calcOptionsLoadError.isValid(), calcOptionsLoadError.errorDetails.toStdString().c_str());
+
+    // Create calculator
+    Star::Calculator calculator;
+    calculator.setOptions(cOptions);
+
+    for(qsizetype i = 0; i < elections.size(); i++)
+    {
+        const Star::Election& patternElection = patternElections.at(i);
+        Star::compareTallies(patternElection, elections.at(i));
+
+        // Results must be identical to those of the individual ballots
+        calculator.setElection(&patternElection);
+        Star::ElectionResult result = calculator.calculateResult();
+        QCOMPARE(result, expectedResults.at(i));
+
+        QCOMPARE(patternSummaries.at(i).ballotCount(), elections.at(i).ballotCount());
+        QCOMPARE(calculator.calculateResult(patternSummaries.at(i)), expectedResults.at(i));
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_weighted_ballots)
+#include "tst_weighted_ballots.moc"